@@ -45,6 +45,18 @@ put '#define CPPGLTF_IMPLEMENTATION' before including this file to create the im
 #include <cmath>
 
 #include <functional>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#ifndef _MSC_VER
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 namespace cppgltf
 {
@@ -68,6 +80,18 @@ namespace cppgltf
 #define CPPGLTF_ASSERT(exp) assert(exp)
 #endif
 
+#ifndef CPPGLTF_NO_SIMD
+#   if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && 2<=_M_IX86_FP)
+#       define CPPGLTF_SSE2 1
+#   endif
+#   if defined(__SSSE3__) || defined(__AVX__) || defined(__AVX2__)
+#       define CPPGLTF_SSSE3 1
+#   endif
+#   if defined(__AVX2__)
+#       define CPPGLTF_AVX2 1
+#   endif
+#endif
+
 #ifndef CPPGLTF_TYPES
 #define CPPGLTF_TYPES
     typedef int8_t s8;
@@ -159,7 +183,7 @@ namespace cppgltf
     {
         if(CPPGLTF_NULL != file){
             fclose(file);
-            file = CPP_NULL;
+            file = CPPGLTF_NULL;
         }
     }
 #endif
@@ -222,9 +246,16 @@ namespace cppgltf
     s32 getLengthDecodedBase64(s32 l);
     s32 decodeBase64(u8* dst, FILE* file);
     /**
+    @brief Decode until the first character which is not base64, padding included
+    @pre dst can hold getLengthDecodedBase64(length) bytes
     @return decoded byte count
     */
     s32 decodeBase64(u8* dst, s32 length, const s8* src);
+    /**
+    @param size ... capacity of dst, decoding stops when it is full. dst past the decoded bytes may be overwritten.
+    @return decoded byte count
+    */
+    s32 decodeBase64(u8* dst, s32 size, s32 length, const s8* src);
     s32 encodeBase64(FILE* file, s32 length, const u8* src);
     /**
     @return encoded char count
@@ -241,6 +272,21 @@ namespace cppgltf
     s16 toS16(f32 x);
     u16 toU16(f32 x);
 
+    /**
+    @brief Convert normalized integers into floats in bulk, the same as toFloat
+    @param dst ... count*numComponents floats, tightly packed
+    @param componentType ... GLTF_TYPE_BYTE, GLTF_TYPE_UNSIGNED_BYTE, GLTF_TYPE_SHORT or GLTF_TYPE_UNSIGNED_SHORT
+    @param srcStride ... bytes between elements of src, 0 for tightly packed
+    @return false if componentType is not one of the above
+    */
+    boolean toFloat(f32* dst, s32 componentType, s32 numComponents, s32 count, s32 srcStride, const void* src);
+    /**
+    @brief Convert floats into normalized integers in bulk, the same as toS8 and the like for values in the range, which others are clamped into
+    @param dstStride ... bytes between elements of dst, 0 for tightly packed
+    @param src ... count*numComponents floats, tightly packed
+    */
+    boolean fromFloat(void* dst, s32 componentType, s32 numComponents, s32 count, s32 dstStride, const f32* src);
+
     //--------------------------------------------
     //---
     //--- String
@@ -731,9 +777,21 @@ namespace cppgltf
         @return Success: input c, Fail: EOF
         */
         virtual s32 unget(s32 c) =0;
-        virtual s32 read(u8* dst, s32 size) =0;
+        /**
+        @return Success: 1, Fail: 0
+        */
+        virtual s32 read(u8* dst, s64 size) =0;
 
         virtual boolean isEOF() const =0;
+        virtual s64 size() const =0;
+
+        /**
+        @return The whole stream if it is contiguous memory, otherwise NULL
+        */
+        virtual const u8* data() const
+        {
+            return CPPGLTF_NULL;
+        }
 
         template<class T>
         s32 read(T& t)
@@ -762,9 +820,11 @@ namespace cppgltf
         boolean seek(off_t pos) override;
         s32 get() override;
         s32 unget(s32 c) override;
-        s32 read(u8* dst, s32 size) override;
+        s32 read(u8* dst, s64 size) override;
 
         boolean isEOF() const override;
+        s64 size() const override;
+        const u8* data() const override;
 
         ISStream& operator=(ISStream&& rhs);
     protected:
@@ -776,6 +836,27 @@ namespace cppgltf
         const u8* str_;
     };
 
+    /**
+    Input stream over a private copy-on-write memory mapping of a whole file.
+    Falls back to reading the whole file into memory where mmap is not available.
+    */
+    class IMMStream : public ISStream
+    {
+    public:
+        IMMStream();
+        IMMStream(IMMStream&& rhs);
+        virtual ~IMMStream();
+
+        bool open(const Char* filepath);
+        void close();
+        bool valid() const;
+
+        IMMStream& operator=(IMMStream&& rhs);
+    protected:
+        IMMStream(const IMMStream&) = delete;
+        IMMStream& operator=(const IMMStream&) = delete;
+    };
+
     class IFStream : public FStream<IStream>
     {
     public:
@@ -790,7 +871,7 @@ namespace cppgltf
         boolean seek(off_t pos) override;
         s32 get() override;
         s32 unget(s32 c) override;
-        s32 read(u8* dst, s32 size) override;
+        s32 read(u8* dst, s64 size) override;
 
         boolean isEOF() const override;
 
@@ -914,6 +995,7 @@ namespace cppgltf
         JSON_True,
         JSON_False,
         JSON_Null,
+        JSON_Source, ///< A string left in place in a contiguous stream, only in the tree of glTFBase
     };
 
     //---------------------------------------------------------------
@@ -941,18 +1023,42 @@ namespace cppgltf
     {
     public:
         RangeStream(IStream* stream, const Range& range);
+        /**
+        @param data ... IStream::data() of the stream
+        */
+        RangeStream(IStream* stream, const u8* data, const Range& range);
         s32 length() const;
+        /**
+        @return The range in place if the stream is contiguous memory, otherwise NULL
+        */
+        inline const Char* data() const;
         s32 read(u8* dst);
         s32 readAsString(Char* str);
         s32 readAsString(String& str);
         s32 readAsInt(s32 defaultValue=0);
+        s64 readAsInt64(s64 defaultValue=0);
         f32 readAsFloat(f32 defaultValue=0.0f);
+        f64 readAsDouble(f64 defaultValue=0.0);
     private:
+        static const s32 MaxNumberSize = 64;
+
+        /**
+        @return The null terminated token, in place, copied into the buffer, or copied into allocated if longer than the buffer
+        @param allocated ... freed by the caller
+        */
+        const Char* readAsNumber(Char*& allocated, Char* buffer, s32 size);
+
         IStream* stream_;
+        const Char* data_;
         off_t start_;
         s32 length_;
     };
 
+    inline const Char* RangeStream::data() const
+    {
+        return data_;
+    }
+
     //---------------------------------------------------------------
     //---
     //--- JSONEventHandler
@@ -972,6 +1078,11 @@ namespace cppgltf
         virtual void root(s32 type, RangeStream value) =0;
         virtual void value(s32 type, RangeStream v) =0;
         virtual void keyValue(RangeStream key, s32 type, RangeStream value) =0;
+        /**
+        @brief Called before the value of the key is read
+        @return false to skip the value, no events are reported for it
+        */
+        virtual boolean key(RangeStream /*key*/){ return true;}
 
         virtual void onError(s32 line, s32 charCount) =0;
     protected:
@@ -1014,12 +1125,51 @@ namespace cppgltf
         */
         s32 getNumber(Range& number);
         s32 getDigit(boolean unget=true);
+        /**
+        @brief Skip a value, objects and arrays are skipped by matching brackets
+        @return Success:type of the value, Fail:JSON_Error
+        */
+        s32 skipValue();
         boolean isNumber(s32 c) const;
         boolean isOneToNine(s32 c) const;
 
+        inline RangeStream getRange(const Range& range)
+        {
+            return RangeStream(&istream_, data_, range);
+        }
+
+        /**
+        @brief Get a character, and count lines if the stream is not contiguous
+        */
+        inline s32 get()
+        {
+            s32 c = istream_.get();
+            if('\n' == c && CPPGLTF_NULL == data_){
+                ++line_;
+                prevLineStart_ = lineStart_;
+                lineStart_ = istream_.tell();
+            }
+            return c;
+        }
+
+        inline s32 unget(s32 c)
+        {
+            if('\n' == c && CPPGLTF_NULL == data_){
+                --line_;
+                lineStart_ = prevLineStart_;
+            }
+            return istream_.unget(c);
+        }
+
         s32 flags_;
         IStream& istream_;
         JSONEventHandler& handler_;
+        const u8* data_;
+        off_t size_;
+        off_t start_;
+        off_t line_;
+        off_t lineStart_;
+        off_t prevLineStart_;
     };
 
     //---------------------------------------------------------------
@@ -1151,8 +1301,9 @@ namespace cppgltf
         union
         {
             s32 int_;
-            f32 float_;
+            f64 float_;
             s32 string_;
+            const Char* source_;
             JSAny* array_;
             JSKeyValue* object_;
         };
@@ -1203,24 +1354,53 @@ namespace cppgltf
 
         static const s32 SmaleSizes[];
 
+        struct Stats
+        {
+            s64 reserved_; ///< Bytes taken from the system.
+            s64 used_; ///< Bytes of pages and large blocks in use.
+            s64 peak_; ///< Peak of used_ since the last destroy.
+            s32 numPages_;
+            s32 numLarges_;
+        };
+
         Allocator();
         ~Allocator();
 
+        /**
+        @brief Return all memory to the system
+        */
         void destroy();
+        /**
+        @brief Discard all allocations, but keep memory for next allocations
+        */
+        void reset();
         void* alloc(s32 num);
         void dealloc(s32 num, void* ptr);
+
+        inline const Stats& getStats() const;
     private:
         Allocator(const Allocator&) = delete;
         Allocator& operator=(const Allocator&) = delete;
 
         void* allocate(s32 num);
+        void* allocateLarge(s32 num);
+        void release(PageMem* mem, s32 num);
+        void addUsed(s64 size);
 
         Page* table_[TableSize]; //1,2,4,8,16,32,64,96,128,160
-        Page* large_;
-        Page* top_;
-        Page* largeTop_;
+        Page* large_; ///< Free large blocks
+        Page* pages_; ///< Pages in use, the top is bumped
+        Page* freePages_; ///< Pages kept by reset
+        Page* largeTop_; ///< All large blocks
+        s32 pageUsed_;
+        Stats stats_;
     };
 
+    inline const Allocator::Stats& Allocator::getStats() const
+    {
+        return stats_;
+    }
+
     //---------------------------------------------------------------
     //---
     //--- glTFBase
@@ -1241,11 +1421,48 @@ namespace cppgltf
     public:
         static const s32 InitSize = 2;
 
+        /**
+        @brief Parse each element of top-level arrays as soon as it is closed, and discard its tree
+        */
+        static const u32 Flag_Streaming = (0x01U<<0);
+        /**
+        @brief Parse elements of large top-level arrays on a thread pool
+        */
+        static const u32 Flag_Parallel = (0x01U<<1);
+        /**
+        @brief Map external buffer files instead of reading them, see glTF::Flag_MapBuffers
+        */
+        static const u32 Flag_MapBuffers = (0x01U<<2);
+        /**
+        @brief Point GLB buffers into the bytes of a contiguous stream instead of copying the BIN chunk.
+        The stream must outlive the glTF, or be handed over with glTF::holdStorage.
+        */
+        static const u32 Flag_ReferenceGLB = (0x01U<<3);
+        /**
+        @brief Load external buffer files on demand, see glTF::Flag_LazyBuffers
+        */
+        static const u32 Flag_LazyBuffers = (0x01U<<4);
+        /**
+        @brief Leave loading buffers to glTFHandler::loadBuffers after reading.
+        Data URIs left in a contiguous stream need the stream until then.
+        */
+        static const u32 Flag_DeferBuffers = (0x01U<<5);
+
         glTFBase();
         virtual ~glTFBase();
 
         void destroy();
 
+        inline u32 getFlags() const;
+        inline void setFlags(u32 flags);
+        inline const Allocator::Stats& getAllocatorStats() const;
+        inline u32 getSkipSections() const;
+        /**
+        @brief Top-level sections to be skipped without being parsed
+        @param sections ... combination of GLTF_SECTION_*
+        */
+        inline void setSkipSections(u32 sections);
+
         void begin() override;
         void end() override;
 
@@ -1256,19 +1473,48 @@ namespace cppgltf
         void root(s32 type, RangeStream value) override;
         void value(s32 type, RangeStream v) override;
         void keyValue(RangeStream key, s32 type, RangeStream value) override;
+        boolean key(RangeStream key) override;
 
         void onError(s32 line, s32 charCount) override;
 
     protected:
+        /**
+        @brief Discard the tree, and keep memory for the next load
+        */
+        void clear();
+
         virtual void parseGlTF(const JSAny& glTF) =0;
+        /**
+        @brief Parse an element of a top-level array in streaming mode
+        @return false if the element should be kept in the tree
+        @param key ... key code of the array in the root object
+        @param index ... index in the array
+        */
+        virtual boolean parseElement(s32 key, s32 index, const JSAny& value);
 
         void expand();
         void expandObject(JSElement& element);
         void expandArray(JSElement& element);
 
         void getString(String& str, const JSAny& value) const;
+        /**
+        @return true if the value is a data URI which can be left in the contiguous source
+        */
+        static boolean isDataURI(const RangeStream& value);
+        /**
+        @return true if the value is a string which is equal to str
+        */
+        boolean equals(const JSAny& value, const Char* str) const;
+        /**
+        @brief Integers which do not fit in 32 bits are kept as JSON_Float, which is exact up to 2^53
+        */
+        static void setInteger(JSAny& value, RangeStream& token);
         bool getBoolean(const JSAny& value) const;
         f32 getNumber(const JSAny& value) const;
+        /**
+        @return The integer, with 64 bits, such as byte offsets and lengths
+        */
+        s64 getInteger(const JSAny& value) const;
         void getNumbers(s32 num, Number* x, const JSAny& value) const;
         void getVec2(f32 v[2], const JSAny& value) const;
         void getVec3(f32 v[3], const JSAny& value) const;
@@ -1291,8 +1537,25 @@ namespace cppgltf
                 array.resize(value.num_);
             }
         }
+        template<class T>
+        inline T& expandElement(Array<T>& array, s32 index)
+        {
+            CPPGLTF_ASSERT(0<=index);
+            if(array.capacity()<=index){
+                array.reserve((array.capacity()<16)? 16 : array.capacity()<<1);
+            }
+            if(array.size()<=index){
+                array.resize(index+1);
+            }
+            return array[index];
+        }
 
         static s32 getKeyCode(const String& key);
+        static s32 getKeyCode(s32 length, const Char* key);
+        /**
+        @return GLTF_SECTION_* of a key code in the root object, 0 if it is not a section
+        */
+        static u32 getSectionFlag(s32 key);
 
         class StringTable
         {
@@ -1302,6 +1565,11 @@ namespace cppgltf
 
             void clear();
             s32 add(s32 length);
+            inline s32 size() const{ return length_;}
+            /**
+            @brief Discard strings added after size() returned length
+            */
+            void truncate(s32 length);
 
             const Char* c_str(s32 start) const;
             Char* c_str(s32 start);
@@ -1319,8 +1587,39 @@ namespace cppgltf
 
         String key_;
         StringTable strings_;
+
+        u32 flags_;
+        u32 skipSections_;
+        s32 section_;
+        s32 sectionStrings_;
+        s32 sectionIndex_;
     };
 
+    inline u32 glTFBase::getFlags() const
+    {
+        return flags_;
+    }
+
+    inline void glTFBase::setFlags(u32 flags)
+    {
+        flags_ = flags;
+    }
+
+    inline const Allocator::Stats& glTFBase::getAllocatorStats() const
+    {
+        return allocator_.getStats();
+    }
+
+    inline u32 glTFBase::getSkipSections() const
+    {
+        return skipSections_;
+    }
+
+    inline void glTFBase::setSkipSections(u32 sections)
+    {
+        skipSections_ = sections;
+    }
+
     //---------------------------------------------------------------
     //---
     //--- glTF
@@ -1398,6 +1697,27 @@ namespace cppgltf
 #define GLTF_CAMERA_TYPE_NAME_PERSPECTIVE "perspective"
 #define GLTF_CAMERA_TYPE_NAME_ORTHOGRAPHIC "orthographic"
 
+    //Top-level sections of glTF, for glTFBase::setSkipSections
+    static const u32 GLTF_SECTION_EXTENSIONSUSED = (0x01U<<0);
+    static const u32 GLTF_SECTION_EXTENSIONSREQUIRED = (0x01U<<1);
+    static const u32 GLTF_SECTION_ACCESSORS = (0x01U<<2);
+    static const u32 GLTF_SECTION_ANIMATIONS = (0x01U<<3);
+    static const u32 GLTF_SECTION_ASSET = (0x01U<<4);
+    static const u32 GLTF_SECTION_BUFFERS = (0x01U<<5);
+    static const u32 GLTF_SECTION_BUFFERVIEWS = (0x01U<<6);
+    static const u32 GLTF_SECTION_CAMERAS = (0x01U<<7);
+    static const u32 GLTF_SECTION_IMAGES = (0x01U<<8);
+    static const u32 GLTF_SECTION_MATERIALS = (0x01U<<9);
+    static const u32 GLTF_SECTION_MESHES = (0x01U<<10);
+    static const u32 GLTF_SECTION_NODES = (0x01U<<11);
+    static const u32 GLTF_SECTION_SAMPLERS = (0x01U<<12);
+    static const u32 GLTF_SECTION_SCENE = (0x01U<<13);
+    static const u32 GLTF_SECTION_SCENES = (0x01U<<14);
+    static const u32 GLTF_SECTION_SKINS = (0x01U<<15);
+    static const u32 GLTF_SECTION_TEXTURES = (0x01U<<16);
+    static const u32 GLTF_SECTION_EXTENSIONS = (0x01U<<17);
+    static const u32 GLTF_SECTION_EXTRAS = (0x01U<<18);
+
     enum GLTF_FILE
     {
         GLTF_FILE_AsIs =0,
@@ -1446,7 +1766,7 @@ namespace cppgltf
         boolean checkRequirements() const;
 
         s32 bufferView_; //required
-        s32 byteOffset_; //default:0
+        s64 byteOffset_; //default:0
         s32 componentType_; //required
         Extensions extensions_;
         Extras extras_;
@@ -1459,7 +1779,7 @@ namespace cppgltf
         boolean checkRequirements() const;
 
         s32 bufferView_; //required
-        s32 byteOffset_; //default:0
+        s64 byteOffset_; //default:0
         Extensions extensions_;
         Extras extras_;
     };
@@ -1488,7 +1808,7 @@ namespace cppgltf
 
         Flags flags_;
         s32 bufferView_;
-        s32 byteOffset_; //default:0
+        s64 byteOffset_; //default:0
         s32 componentType_; //required
         boolean normalized_; //default:false
         s32 count_; //required
@@ -1565,6 +1885,106 @@ namespace cppgltf
         Extras extras_;
     };
 
+    //---------------------------------------------------------------
+    //---
+    //--- FileProvider
+    //---
+    //---------------------------------------------------------------
+    /**
+    Source of the files which URIs of buffers and images refer to.
+    Implementations must be thread safe, glTF::loadBuffers may read buffers concurrently.
+    */
+    class FileProvider
+    {
+    public:
+        typedef void* Handle;
+
+        virtual ~FileProvider()
+        {}
+
+        /**
+        @return NULL if failed
+        */
+        virtual Handle open(const String& uri, const String& directory) =0;
+        virtual void close(Handle handle) =0;
+        /**
+        @return Size in bytes, negative if failed
+        */
+        virtual s64 size(Handle handle) =0;
+        /**
+        @brief Read size bytes at offset of a file
+        */
+        virtual boolean read(Handle handle, s64 offset, s64 size, u8* dst) =0;
+    protected:
+        FileProvider()
+        {}
+    private:
+        FileProvider(const FileProvider&) = delete;
+        FileProvider& operator=(const FileProvider&) = delete;
+    };
+
+    /**
+    Files in the file system at directory + uri
+    */
+    class StdioFileProvider : public FileProvider
+    {
+    public:
+        static StdioFileProvider& getDefault();
+
+        Handle open(const String& uri, const String& directory) override;
+        void close(Handle handle) override;
+        s64 size(Handle handle) override;
+        boolean read(Handle handle, s64 offset, s64 size, u8* dst) override;
+    };
+
+    /**
+    Files at ranges of one uncompressed pack file, such as a tar archive, read through a single handle.
+    A file is found by directory + uri, without a leading "./".
+    */
+    class PackFileProvider : public FileProvider
+    {
+    public:
+        PackFileProvider();
+        virtual ~PackFileProvider();
+
+        /**
+        @brief Open a pack file. The entries of a tar archive are added, other formats need add.
+        */
+        bool openPack(const Char* filepath);
+        void closePack();
+        /**
+        @brief Register a file at a range of the pack file. Not thread safe.
+        */
+        void add(const Char* name, s64 offset, s64 size);
+        s32 getNumEntries() const;
+
+        Handle open(const String& uri, const String& directory) override;
+        void close(Handle handle) override;
+        s64 size(Handle handle) override;
+        boolean read(Handle handle, s64 offset, s64 size, u8* dst) override;
+    private:
+        struct Entry
+        {
+            String name_;
+            s64 offset_;
+            s64 size_;
+        };
+
+        void readTar();
+        /**
+        @return Index of the entry, -1 if not found
+        */
+        s32 find(s32 length, const Char* name) const;
+
+        FILE* file_;
+        s64 fileSize_;
+        Array<Entry> entries_;
+        Array<s32> sorted_; ///< Indices of entries in order of the names
+#ifdef _MSC_VER
+        std::mutex mutex_;
+#endif
+    };
+
     class Buffer
     {
     public:
@@ -1573,14 +1993,21 @@ namespace cppgltf
         boolean checkRequirements() const;
 
         String uri_;
-        s32 byteLength_; //required
+        s64 byteLength_; //required
         String name_;
         Extensions extensions_;
         Extras extras_;
         u8* data_;
+
+        /// Base64 payload of a data URI left in the source stream, uri_ has only its header then.
+        /// Valid only while the stream is being read.
+        const Char* source_;
+        /// -1 once the stream is gone after glTFHandler::loadBuffers, then the data URI can not be decoded again
+        s32 sourceLength_;
     };
 
     boolean load(Buffer& buffer, const String& directory);
+    boolean load(Buffer& buffer, const String& directory, FileProvider& provider);
     boolean save(String& uri, const Buffer& buffer, const String& directory);
 
     class BufferView
@@ -1590,8 +2017,8 @@ namespace cppgltf
         boolean checkRequirements() const;
 
         s32 buffer_; //required
-        s32 byteOffset_; //default:0;
-        s32 byteLength_; //required
+        s64 byteOffset_; //default:0;
+        s64 byteLength_; //required
         s32 byteStride_;
         s32 target_;
         String name_;
@@ -1849,19 +2276,62 @@ namespace cppgltf
         Extras extras_;
     };
 
+    class ThreadPool;
+
     //---------------------------------------------------------------
     class glTF
     {
     public:
+        /// Map external buffer files copy-on-write instead of reading them into one block
+        static const u32 Flag_MapBuffers = (0x01U<<0);
+        /// Load external buffer files on the first request through getBufferData and the like
+        static const u32 Flag_LazyBuffers = (0x01U<<1);
+
         glTF();
         ~glTF();
 
         void initialize();
         void setDirectory(const Char* directory);
 
-        boolean loadBuffers();
+        /**
+        @brief Load external and embedded buffers into one block
+        @param threadPool ... if not null, the buffers are loaded concurrently on it
+        @param flags ... Flag_MapBuffers, Flag_LazyBuffers
+        */
+        boolean loadBuffers(ThreadPool* threadPool = CPPGLTF_NULL, u32 flags = 0);
         boolean loadGLBBuffers();
 
+        /**
+        @brief Data of a buffer, loaded here if it was deferred by Flag_LazyBuffers. Thread safe.
+        @return NULL if the buffer has no data or failed to be loaded
+        */
+        u8* getBufferData(s32 buffer);
+        /**
+        @brief Read only the byte ranges of bufferViews from external buffer files.
+        Adjacent ranges in a file are merged into one read. Views of buffers already in memory are skipped.
+        The data are available through getBufferViewData and getAccessorData, not through Buffer::data_.
+        Must not be called concurrently with the other accessors of buffer data.
+        */
+        boolean loadBufferViews(s32 numBufferViews, const s32* bufferViews);
+
+        /**
+        @brief Read buffer files through a provider instead of the file system. Flag_MapBuffers reads them then.
+        @param provider ... not owned, NULL for the file system
+        */
+        void setFileProvider(FileProvider* provider);
+        /**
+        @brief The provider of buffer files, also for files of images
+        */
+        FileProvider& getFileProvider();
+        /**
+        @return The first byte of a bufferView, NULL if not available
+        */
+        u8* getBufferViewData(s32 bufferView);
+        /**
+        @return The first element of an accessor, NULL if not available or the accessor has no bufferView
+        */
+        u8* getAccessorData(s32 accessor);
+
         boolean checkRequirements() const;
 
         String directory_;
@@ -1886,15 +2356,24 @@ namespace cppgltf
         Extensions extensions_;
         Extras extras_;
 
-        void allocate(u32 size);
-        u32 size() const;
-        const u8* getBin(u32 offset) const;
-        u8* getBin(u32 offset);
+        void allocate(s64 size);
+        s64 size() const;
+        const u8* getBin(s64 offset) const;
+        u8* getBin(s64 offset);
+
+        void allocateGLB(s64 size);
+        /**
+        @brief Use memory owned by someone else as the GLB binary, nothing is copied
+        */
+        void referenceGLB(s64 size, u8* data);
+        s64 sizeGLB() const;
+        const u8* getGLB(s64 offset) const;
+        u8* getGLB(s64 offset);
 
-        void allocateGLB(u32 size);
-        u32 sizeGLB() const;
-        const u8* getGLB(u32 offset) const;
-        u8* getGLB(u32 offset);
+        /**
+        @brief Keep a mapped file alive as long as this, for buffers referencing it
+        */
+        void holdStorage(IMMStream&& storage);
 
         struct Counter
         {
@@ -1947,7 +2426,7 @@ namespace cppgltf
         @pre The size of nodes is larger than or equal to the size glTF::nodes_.
         */
         void getSortedNodes(SortNode* nodes) const;
-        static boolean glTF::isRoot(s32 node, const Array<Node>& nodes);
+        static boolean isRoot(s32 node, const Array<Node>& nodes);
         static s32 addChildren(s32 parent, s32 dstSize, SortNode* dst, const Array<Node>& nodes);
     private:
         glTF(const glTF&) =delete;
@@ -1957,41 +2436,553 @@ namespace cppgltf
 
         void traverseChildren(s32 rootNode, std::function<void(const Node&, const glTF&)> func) const;
 
-        u32 size_;
+        /**
+        Memory of a buffer which does not live in bin_
+        */
+        struct BufferStorage
+        {
+            u8* data_;
+            s64 length_;
+            boolean mapped_;
+        };
+
+        static const s32 Base64ChunkSize = 256*1024;
+        /// Ranges closer than this are read at once, along with the gap
+        static const s32 MaxReadGap = 4*1024;
+
+        boolean loadBuffer(s32 index, u32 flags, ThreadPool* threadPool);
+        /**
+        @brief Map or read an external buffer file into its own storage
+        */
+        boolean loadStorage(s32 index, u32 flags);
+        /**
+        @brief Decode a base64 payload in chunks on the thread pool
+        */
+        boolean decodeBuffer(Buffer& buffer, s32 length, const Char* src, ThreadPool& threadPool);
+        void releaseBuffers();
+
+        s64 size_;
         u8* bin_;
-        u32 glbSize_;
+        s64 glbSize_;
         u8* glbBin_;
+        boolean glbReference_;
+        u32 loadFlags_;
+        FileProvider* fileProvider_;
+        Array<BufferStorage> bufferStorages_;
+        Array<u8*> viewBlocks_;
+        Array<u8*> viewData_;
+        std::mutex bufferMutex_;
+        IMMStream storage_;
     };
 
     //---------------------------------------------------------------
     //---
-    //--- glTFHandler
+    //--- AccessorView
     //---
     //---------------------------------------------------------------
-    class glTFHandler : public glTFBase
+    /**
+    @return Size of a component in bytes, 0 if unknown
+    */
+    s32 getComponentSize(s32 componentType);
+    /**
+    @return Number of components of an element, 0 if unknown
+    */
+    s32 getNumComponents(s32 type);
+    /**
+    @return Size of an element in bytes, with the columns of matrices aligned to 4 bytes
+    */
+    s32 getElementSize(s32 componentType, s32 type);
+    /**
+    @brief Resolve the data of an accessor, checking that all of the elements are in its bufferView
+    @param stride ... bytes between elements
+    @return NULL if the accessor has no bufferView, or its data are not available or short
+    */
+    u8* getAccessorElements(s32& stride, glTF& gltf, s32 accessor);
+    /**
+    @brief Convert the elements of a normalized accessor into tightly packed floats, float accessors are copied
+    @param dst ... count*getNumComponents(type_) floats
+    @return false if the accessor is neither normalized nor float, is a matrix of padded columns, or its data are not available
+    Sparse accessors are materialized first.
+    */
+    boolean dequantize(f32* dst, glTF& gltf, s32 accessor);
+    /**
+    @brief Write tightly packed floats back into the elements of a normalized or float accessor in its buffer
+    @return false also for sparse accessors, of which the bufferView may be shared as the base of others
+    */
+    boolean quantize(glTF& gltf, s32 accessor, const f32* src);
+    /**
+    @brief Resolve an accessor into tightly packed elements, copying its bufferView or zeros, then substituting its sparse values
+    @param dst ... count_*getElementSize(componentType_, type_) bytes
+    @return false if the data are not available or short, the sparse indices or values have no bufferView, or a sparse index is out of the accessor
+    */
+    boolean materialize(u8* dst, glTF& gltf, s32 accessor);
+
+    template<s32 ComponentType> struct ComponentTraits;
+    template<> struct ComponentTraits<GLTF_TYPE_BYTE>{ typedef s8 type; };
+    template<> struct ComponentTraits<GLTF_TYPE_UNSIGNED_BYTE>{ typedef u8 type; };
+    template<> struct ComponentTraits<GLTF_TYPE_SHORT>{ typedef s16 type; };
+    template<> struct ComponentTraits<GLTF_TYPE_UNSIGNED_SHORT>{ typedef u16 type; };
+    template<> struct ComponentTraits<GLTF_TYPE_INT>{ typedef s32 type; };
+    template<> struct ComponentTraits<GLTF_TYPE_UNSIGNED_INT>{ typedef u32 type; };
+    template<> struct ComponentTraits<GLTF_TYPE_FLOAT>{ typedef f32 type; };
+
+    template<s32 Type> struct TypeTraits;
+    template<> struct TypeTraits<GLTF_TYPE_SCALAR>{ static const s32 Rows = 1; static const s32 Columns = 1; };
+    template<> struct TypeTraits<GLTF_TYPE_VEC2>{ static const s32 Rows = 2; static const s32 Columns = 1; };
+    template<> struct TypeTraits<GLTF_TYPE_VEC3>{ static const s32 Rows = 3; static const s32 Columns = 1; };
+    template<> struct TypeTraits<GLTF_TYPE_VEC4>{ static const s32 Rows = 4; static const s32 Columns = 1; };
+    template<> struct TypeTraits<GLTF_TYPE_MAT2>{ static const s32 Rows = 2; static const s32 Columns = 2; };
+    template<> struct TypeTraits<GLTF_TYPE_MAT3>{ static const s32 Rows = 3; static const s32 Columns = 3; };
+    template<> struct TypeTraits<GLTF_TYPE_MAT4>{ static const s32 Rows = 4; static const s32 Columns = 4; };
+
+    /**
+    An element of an accessor with its layout in a buffer
+    */
+    template<s32 ComponentType, s32 Type>
+    struct AccessorElement
     {
-    public:
-        glTFHandler();
-        glTFHandler(const Char* directory);
-        virtual ~glTFHandler();
+        typedef typename ComponentTraits<ComponentType>::type component_type;
+        static const s32 Rows = TypeTraits<Type>::Rows;
+        static const s32 Columns = TypeTraits<Type>::Columns;
+        /// Columns of matrices start at 4-byte boundaries
+        static const s32 ColumnStride = (1<Columns)? static_cast<s32>(((Rows*sizeof(component_type)+3)&~static_cast<size_type>(3))/sizeof(component_type)) : Rows;
 
-        inline const glTF& get() const;
-        inline glTF& get();
-    protected:
-        void parseGlTF(const JSAny& glTF) override;
+        inline const component_type& operator[](s32 index) const{ return v_[index];}
+        inline component_type& operator[](s32 index){ return v_[index];}
+        inline const component_type& operator()(s32 row, s32 column) const{ return v_[column*ColumnStride+row];}
+        inline component_type& operator()(s32 row, s32 column){ return v_[column*ColumnStride+row];}
 
-        virtual void parseAccessor(Accessor& accessor, const JSAny& value);
-        virtual void parseSparse(Sparse& sparse, const JSAny& value);
-        virtual void parseIndices(Indices& indices, const JSAny& value);
-        virtual void parseValues(Values& values, const JSAny& value);
-        virtual void parseAnimation(Animation& animation, const JSAny& value);
-        virtual void parseChannel(Channel& channel, const JSAny& value);
-        virtual void parseTarget(Target& target, const JSAny& value);
-        virtual void parseAnimationSampler(AnimationSampler& sampler, const JSAny& value);
-        virtual void parseAsset(Asset& asset, const JSAny& value);
-        virtual void parseBuffer(Buffer& buffer, const JSAny& value);
-        virtual void parseBufferView(BufferView& bufferView, const JSAny& value);
-        virtual void parseCamera(Camera& camera, const JSAny& value);
+        component_type v_[ColumnStride*Columns];
+    };
+
+    /**
+    The pair of componentType and type of an element type.
+    Specialize for application types which have the same layout.
+    */
+    template<class T> struct AccessorTraits;
+    template<s32 C, s32 E> struct AccessorTraits<AccessorElement<C, E> >{ static const s32 ComponentType = C; static const s32 Type = E; };
+    template<> struct AccessorTraits<s8>{ static const s32 ComponentType = GLTF_TYPE_BYTE; static const s32 Type = GLTF_TYPE_SCALAR; };
+    template<> struct AccessorTraits<u8>{ static const s32 ComponentType = GLTF_TYPE_UNSIGNED_BYTE; static const s32 Type = GLTF_TYPE_SCALAR; };
+    template<> struct AccessorTraits<s16>{ static const s32 ComponentType = GLTF_TYPE_SHORT; static const s32 Type = GLTF_TYPE_SCALAR; };
+    template<> struct AccessorTraits<u16>{ static const s32 ComponentType = GLTF_TYPE_UNSIGNED_SHORT; static const s32 Type = GLTF_TYPE_SCALAR; };
+    template<> struct AccessorTraits<s32>{ static const s32 ComponentType = GLTF_TYPE_INT; static const s32 Type = GLTF_TYPE_SCALAR; };
+    template<> struct AccessorTraits<u32>{ static const s32 ComponentType = GLTF_TYPE_UNSIGNED_INT; static const s32 Type = GLTF_TYPE_SCALAR; };
+    template<> struct AccessorTraits<f32>{ static const s32 ComponentType = GLTF_TYPE_FLOAT; static const s32 Type = GLTF_TYPE_SCALAR; };
+
+    typedef AccessorElement<GLTF_TYPE_FLOAT, GLTF_TYPE_VEC2> AccessorVec2f;
+    typedef AccessorElement<GLTF_TYPE_FLOAT, GLTF_TYPE_VEC3> AccessorVec3f;
+    typedef AccessorElement<GLTF_TYPE_FLOAT, GLTF_TYPE_VEC4> AccessorVec4f;
+    typedef AccessorElement<GLTF_TYPE_FLOAT, GLTF_TYPE_MAT4> AccessorMat4f;
+
+    /**
+    Typed view of the elements of an accessor, which steps by the byteStride of its bufferView.
+    The data are referenced in place, so the view is valid while the buffers of the glTF are loaded.
+    Sparse accessors are not viewed in place, materialize resolves them.
+    */
+    template<class T>
+    class AccessorView
+    {
+    public:
+        typedef T value_type;
+        typedef AccessorView<T> this_type;
+        static const s32 ComponentType = AccessorTraits<T>::ComponentType;
+        static const s32 Type = AccessorTraits<T>::Type;
+        static_assert(sizeof(T) == sizeof(AccessorElement<ComponentType, Type>), "T does not have the layout of its componentType and type");
+
+        class const_iterator
+        {
+        public:
+            const_iterator(const u8* data, s32 stride)
+                :data_(data)
+                ,stride_(stride)
+            {}
+            inline const T& operator*() const{ return *reinterpret_cast<const T*>(data_);}
+            inline const T* operator->() const{ return reinterpret_cast<const T*>(data_);}
+            inline const_iterator& operator++(){ data_ += stride_; return *this;}
+            inline bool operator==(const const_iterator& rhs) const{ return data_ == rhs.data_;}
+            inline bool operator!=(const const_iterator& rhs) const{ return data_ != rhs.data_;}
+        private:
+            const u8* data_;
+            s32 stride_;
+        };
+
+        AccessorView();
+        /**
+        @brief Resolve bufferView, buffer and data of an accessor, loading a lazy buffer
+        */
+        AccessorView(glTF& gltf, s32 accessor);
+
+        /**
+        @return false if the accessor is not of T, is sparse, has no bufferView, or its data are not available or short
+        */
+        boolean reset(glTF& gltf, s32 accessor);
+        inline boolean valid() const;
+        inline s32 size() const;
+        /**
+        @return Bytes between elements
+        */
+        inline s32 stride() const;
+        /**
+        @return true if elements are tightly packed
+        */
+        inline boolean isPacked() const;
+        /**
+        @return The elements as an array if they are tightly packed, otherwise NULL
+        */
+        inline const T* data() const;
+
+        inline const T& operator[](s32 index) const;
+        inline const_iterator begin() const;
+        inline const_iterator end() const;
+
+        /**
+        @brief Call func(const T&) for each element, choosing the packed or strided loop once
+        */
+        template<class F>
+        void forEach(F func) const;
+    private:
+        const u8* data_;
+        s32 size_;
+        s32 stride_;
+    };
+
+    template<class T>
+    AccessorView<T>::AccessorView()
+        :data_(CPPGLTF_NULL)
+        ,size_(0)
+        ,stride_(sizeof(T))
+    {
+    }
+
+    template<class T>
+    AccessorView<T>::AccessorView(glTF& gltf, s32 accessor)
+        :data_(CPPGLTF_NULL)
+        ,size_(0)
+        ,stride_(sizeof(T))
+    {
+        reset(gltf, accessor);
+    }
+
+    template<class T>
+    boolean AccessorView<T>::reset(glTF& gltf, s32 accessor)
+    {
+        data_ = CPPGLTF_NULL;
+        size_ = 0;
+        stride_ = sizeof(T);
+        if(accessor<0 || gltf.accessors_.size()<=accessor){
+            return false;
+        }
+        const Accessor& target = gltf.accessors_[accessor];
+        if(ComponentType != target.componentType_ || Type != target.type_ || 0<target.sparse_.count_){
+            return false;
+        }
+        s32 stride;
+        const u8* data = getAccessorElements(stride, gltf, accessor);
+        if(CPPGLTF_NULL == data){
+            return false;
+        }
+        data_ = data;
+        size_ = target.count_;
+        stride_ = stride;
+        return true;
+    }
+
+    template<class T>
+    inline boolean AccessorView<T>::valid() const
+    {
+        return CPPGLTF_NULL != data_;
+    }
+
+    template<class T>
+    inline s32 AccessorView<T>::size() const
+    {
+        return size_;
+    }
+
+    template<class T>
+    inline s32 AccessorView<T>::stride() const
+    {
+        return stride_;
+    }
+
+    template<class T>
+    inline boolean AccessorView<T>::isPacked() const
+    {
+        return static_cast<s32>(sizeof(T)) == stride_;
+    }
+
+    template<class T>
+    inline const T* AccessorView<T>::data() const
+    {
+        return isPacked()? reinterpret_cast<const T*>(data_) : CPPGLTF_NULL;
+    }
+
+    template<class T>
+    inline const T& AccessorView<T>::operator[](s32 index) const
+    {
+        CPPGLTF_ASSERT(0<=index && index<size_);
+        return *reinterpret_cast<const T*>(data_ + static_cast<s64>(stride_)*index);
+    }
+
+    template<class T>
+    inline typename AccessorView<T>::const_iterator AccessorView<T>::begin() const
+    {
+        return const_iterator(data_, stride_);
+    }
+
+    template<class T>
+    inline typename AccessorView<T>::const_iterator AccessorView<T>::end() const
+    {
+        return const_iterator(data_ + static_cast<s64>(stride_)*size_, stride_);
+    }
+
+    template<class T>
+    template<class F>
+    void AccessorView<T>::forEach(F func) const
+    {
+        if(isPacked()){
+            const T* elements = reinterpret_cast<const T*>(data_);
+            for(s32 i=0; i<size_; ++i){
+                func(elements[i]);
+            }
+        }else{
+            const u8* element = data_;
+            for(s32 i=0; i<size_; ++i){
+                func(*reinterpret_cast<const T*>(element));
+                element += stride_;
+            }
+        }
+    }
+
+    //---------------------------------------------------------------
+    //---
+    //--- ThreadPool
+    //---
+    //---------------------------------------------------------------
+    class ThreadPool
+    {
+    public:
+        typedef std::function<void(s32 begin, s32 end)> Function;
+
+        ThreadPool();
+        ~ThreadPool();
+
+        /**
+        @param numThreads ... number of workers, 0 for the number of hardware threads minus the caller
+        */
+        void start(s32 numThreads);
+        void stop();
+        inline s32 size() const;
+
+        /**
+        @brief Call func for chunks of [0, count) on the workers and the calling thread, and wait for all of them
+        */
+        void parallelFor(s32 count, s32 chunkSize, const Function& func);
+    private:
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        void run();
+        void work();
+
+        s32 numThreads_;
+        std::thread* threads_;
+        std::mutex mutex_;
+        std::condition_variable wake_;
+        std::condition_variable done_;
+        u32 generation_;
+        boolean stop_;
+        s32 running_;
+
+        const Function* function_;
+        s32 count_;
+        s32 chunkSize_;
+        std::atomic<s32> next_;
+    };
+
+    inline s32 ThreadPool::size() const
+    {
+        return numThreads_;
+    }
+
+    //---------------------------------------------------------------
+    //---
+    //--- VertexLayout
+    //---
+    //---------------------------------------------------------------
+    class VertexElement
+    {
+    public:
+        void initialize();
+
+        s8 semanticType_;
+        s8 semanticIndex_;
+        s16 stream_;
+        s32 offset_; //in a vertex of the stream
+        s32 componentType_;
+        s32 numComponents_; //1 to 4
+        boolean normalized_;
+    };
+
+    /**
+    @brief Formats and places of vertex attributes in one or more interleaved streams
+    */
+    class VertexLayout
+    {
+    public:
+        static const s32 MaxStreams = 8;
+
+        VertexLayout();
+        ~VertexLayout();
+
+        void clear();
+
+        /**
+        @brief Add an element at the end of a stream, aligned to 4 bytes
+        @return false if the stream or the format is not supported
+        */
+        boolean add(s32 semanticType, s32 semanticIndex, s32 componentType, s32 numComponents, boolean normalized = false, s32 stream = 0);
+        /**
+        @brief Add an element at its own offset_, the stride of the stream grows to cover it
+        */
+        boolean add(const VertexElement& element);
+
+        inline s32 getNumElements() const;
+        inline const VertexElement& getElement(s32 index) const;
+        /**
+        @return Bytes of a vertex in a stream, multiple of 4
+        */
+        inline s32 getStride(s32 stream) const;
+    private:
+        VertexLayout(const VertexLayout&) = delete;
+        VertexLayout& operator=(const VertexLayout&) = delete;
+
+        Array<VertexElement> elements_;
+        s32 strides_[MaxStreams];
+    };
+
+    inline s32 VertexLayout::getNumElements() const
+    {
+        return elements_.size();
+    }
+
+    inline const VertexElement& VertexLayout::getElement(s32 index) const
+    {
+        return elements_[index];
+    }
+
+    inline s32 VertexLayout::getStride(s32 stream) const
+    {
+        CPPGLTF_ASSERT(0<=stream && stream<MaxStreams);
+        return strides_[stream];
+    }
+
+    /**
+    @return Number of vertices, the count of POSITION or the first attribute, -1 if no attribute
+    */
+    s32 getNumVertices(glTF& gltf, const Primitive& primitive);
+
+    /**
+    @brief Gather the attributes of a primitive into the streams of a layout, converting their formats
+
+    Components which the accessor does not have are 0, but the fourth is 1. Attributes which the primitive does not have are all 0.
+    Sparse accessors are materialized first.
+    @param streams ... getNumVertices*layout.getStride(stream) bytes for each stream used
+    @param threadPool ... split ranges of vertices on, can be NULL
+    @return false if an attribute is not available, or has a matrix type or fewer elements than the vertices
+    */
+    boolean interleave(u8* const* streams, glTF& gltf, const Primitive& primitive, const VertexLayout& layout, ThreadPool* threadPool = CPPGLTF_NULL);
+
+    //---------------------------------------------------------------
+    //---
+    //--- Index
+    //---
+    //---------------------------------------------------------------
+    /**
+    @brief Widen or narrow indices of GLTF_TYPE_UNSIGNED_BYTE, GLTF_TYPE_UNSIGNED_SHORT or GLTF_TYPE_UNSIGNED_INT
+    @param src ... count indices, tightly packed
+    @return false if the componentType is unknown, or an index does not fit in dst
+    */
+    boolean convertIndices(u32* dst, s32 componentType, s32 count, const void* src);
+    boolean convertIndices(u16* dst, s32 componentType, s32 count, const void* src);
+
+    /**
+    @return GLTF_PRIMITIVE_POINTS, GLTF_PRIMITIVE_LINES or GLTF_PRIMITIVE_TRIANGLES which a mode becomes as a list, -1 if unknown
+    */
+    s32 getListMode(s32 mode);
+    /**
+    @return Number of indices of a mode as a list from count indices, dropping an incomplete primitive at the end
+    */
+    s32 getNumListIndices(s32 mode, s32 count);
+    /**
+    @return Number of indices of a primitive as a list, -1 if unknown
+    */
+    s32 getNumListIndices(glTF& gltf, const Primitive& primitive);
+
+    /**
+    @brief Read the indices of a primitive as a list of getListMode(primitive.mode_), which are sequential for a non-indexed primitive
+    @param dst ... getNumListIndices(gltf, primitive) indices
+    @return false if the indices are not available, or an index does not fit in dst
+    */
+    boolean getListIndices(u32* dst, glTF& gltf, const Primitive& primitive);
+    boolean getListIndices(u16* dst, glTF& gltf, const Primitive& primitive);
+
+    //---------------------------------------------------------------
+    //---
+    //--- glTFHandler
+    //---
+    //---------------------------------------------------------------
+    class glTFHandler : public glTFBase
+    {
+    public:
+        glTFHandler();
+        glTFHandler(const Char* directory);
+        virtual ~glTFHandler();
+
+        inline const glTF& get() const;
+        inline glTF& get();
+
+        /**
+        @brief Number of threads for Flag_Parallel, 0 for the number of hardware threads
+        */
+        void setNumThreads(s32 numThreads);
+        /**
+        @brief Load the buffers with the flags of this handler, which is done at the end of reading unless Flag_DeferBuffers
+        Data URIs left in the source are decoded only by this, the buffers fail to load again later.
+        */
+        boolean loadBuffers();
+
+        void begin() override;
+    protected:
+        static const s32 MinParallelCount = 256;
+        static const s32 MinParallelDecode = 1024*1024;
+
+        void parseGlTF(const JSAny& glTF) override;
+        boolean parseElement(s32 key, s32 index, const JSAny& value) override;
+
+        /**
+        @brief Call func for [0, count) on the thread pool if Flag_Parallel is set.
+        The parse functions called from func must not modify the state of the handler.
+        */
+        void parallelFor(s32 count, const ThreadPool::Function& func);
+        ThreadPool& getThreadPool();
+        /**
+        @brief Set the uri of a buffer, leaving the payload of a data URI in the source
+        */
+        void getDataURI(Buffer& buffer, const JSAny& value) const;
+
+        virtual void parseAccessor(Accessor& accessor, const JSAny& value);
+        virtual void parseSparse(Sparse& sparse, const JSAny& value);
+        virtual void parseIndices(Indices& indices, const JSAny& value);
+        virtual void parseValues(Values& values, const JSAny& value);
+        virtual void parseAnimation(Animation& animation, const JSAny& value);
+        virtual void parseChannel(Channel& channel, const JSAny& value);
+        virtual void parseTarget(Target& target, const JSAny& value);
+        virtual void parseAnimationSampler(AnimationSampler& sampler, const JSAny& value);
+        virtual void parseAsset(Asset& asset, const JSAny& value);
+        virtual void parseBuffer(Buffer& buffer, const JSAny& value);
+        virtual void parseBufferView(BufferView& bufferView, const JSAny& value);
+        virtual void parseCamera(Camera& camera, const JSAny& value);
         virtual void parseOrthographic(Orthographic& orthographic, const JSAny& value);
         virtual void parsePerspective(Perspective& perspective, const JSAny& value);
         virtual void parseImage(Image& image, const JSAny& value);
@@ -2013,6 +3004,8 @@ namespace cppgltf
         virtual void parseExtras(Extras& extras, const JSAny& value);
 
         glTF gltf_;
+        s32 numThreads_;
+        ThreadPool threadPool_;
     };
 
     inline const glTF& glTFHandler::get() const
@@ -2079,41 +3072,124 @@ namespace cppgltf
         GLBEventHandler& handler_;
     };
 
-
     //---------------------------------------------------------------
     //---
-    //--- glTFWriter
+    //--- AsyncLoader
     //---
     //---------------------------------------------------------------
-    class glTFWriter
+    /**
+    Read a glTF or GLB file and load its buffers on a worker thread.
+    Callbacks are called on the worker thread. After onJSON, everything but the data of buffers can be read,
+    and nothing can be modified until the load is done.
+    */
+    class AsyncLoader
     {
     public:
-        static const u32 Flag_Format = 0x01U<<0; 
-
-        struct Indent
+        enum State
         {
-            Indent(s32& indent)
-                :indent_(indent)
-            {
-                ++indent_;
-            }
-            ~Indent()
-            {
-                --indent_;
-            }
-            s32& indent_;
+            State_Idle =0,
+            State_Parsing,
+            State_LoadingBuffers,
+            State_Done,
+            State_Failed,
         };
+        typedef std::function<void(AsyncLoader& loader)> Callback;
 
-        glTFWriter(OStream& ostream);
-        ~glTFWriter();
+        AsyncLoader();
+        /**
+        @brief Wait for the running load
+        */
+        ~AsyncLoader();
 
         /**
-        @param gltf
-        @param type ... file type
+        @brief Start loading and return immediately. GLB is told by its magic.
+        @param flags ... flags of glTFBase, Flag_Parallel to load and decode buffers on the thread pool
+        @param onJSON ... called when the JSON has been read, may be empty
+        @param onBuffers ... called at the end whether succeeded or not, may be empty
+        @return false if a load is running until its onBuffers returns, so also if called from the callbacks, or the file can not be opened
         */
-        bool write(const glTF& gltf, GLTF_FILE type, u32 flags);
-    private:
-        void printIndent();
+        boolean start(const Char* filepath, u32 flags, Callback onJSON, Callback onBuffers);
+        void wait();
+
+        inline s32 getState() const;
+        /**
+        @return true if succeeded or failed
+        */
+        inline boolean isDone() const;
+        inline glTF& get();
+        /**
+        @brief The handler, such as for setNumThreads or setSkipSections before start
+        */
+        inline GLBEventHandler& getHandler();
+    private:
+        AsyncLoader(const AsyncLoader&) = delete;
+        AsyncLoader& operator=(const AsyncLoader&) = delete;
+
+        void run(Callback onJSON, Callback onBuffers);
+
+        GLBEventHandler handler_;
+        IMMStream istream_;
+        std::thread thread_;
+        std::atomic<s32> state_;
+        std::atomic<boolean> running_; ///< From start to the end of the worker, which never reads thread_
+    };
+
+    inline s32 AsyncLoader::getState() const
+    {
+        return state_.load(std::memory_order_acquire);
+    }
+
+    inline boolean AsyncLoader::isDone() const
+    {
+        s32 state = getState();
+        return State_Done == state || State_Failed == state;
+    }
+
+    inline glTF& AsyncLoader::get()
+    {
+        return handler_.get();
+    }
+
+    inline GLBEventHandler& AsyncLoader::getHandler()
+    {
+        return handler_;
+    }
+
+
+    //---------------------------------------------------------------
+    //---
+    //--- glTFWriter
+    //---
+    //---------------------------------------------------------------
+    class glTFWriter
+    {
+    public:
+        static const u32 Flag_Format = 0x01U<<0; 
+
+        struct Indent
+        {
+            Indent(s32& indent)
+                :indent_(indent)
+            {
+                ++indent_;
+            }
+            ~Indent()
+            {
+                --indent_;
+            }
+            s32& indent_;
+        };
+
+        glTFWriter(OStream& ostream);
+        ~glTFWriter();
+
+        /**
+        @param gltf
+        @param type ... file type
+        */
+        bool write(const glTF& gltf, GLTF_FILE type, u32 flags);
+    private:
+        void printIndent();
         void printLine();
         void printSeparator();
         void printSeparatorLine();
@@ -2124,6 +3200,7 @@ namespace cppgltf
         bool print(const String& str);
         bool print(s32 value);
         bool print(u32 value);
+        bool print(s64 value);
         bool print(f32 value);
         bool print(boolean value);
         void printNull();
@@ -2136,6 +3213,7 @@ namespace cppgltf
         void printObjectProperty(const Char* key, const String& value);
         void printObjectProperty(const Char* key, const Char* value);
         void printObjectProperty(const Char* key, s32 value);
+        void printObjectProperty(const Char* key, s64 value);
         void printObjectProperty(const Char* key, f32 value);
         void printObjectProperty(const Char* key, s32 num, const f32* value);
         void printObjectProperty(const Char* key, s32 num, const s32* value);
@@ -2259,35 +3337,141 @@ namespace cppgltf
 #endif //INC_CPPGLTF_H_
 
 #ifdef CPPGLTF_IMPLEMENTATION
+#if defined(CPPGLTF_SSE2) || defined(CPPGLTF_AVX2)
+#include <immintrin.h>
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
 namespace cppgltf
 {
 namespace
 {
     static const s8 Base64Chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
     static const s8 Base64PadChar = '=';
-    s32 getIndexBase64Chars(s8 c)
-    {
-        if('A'<=c && c<='Z'){
-            return c-'A';
-
-        }else if('a'<=c && c<='z'){
-            return c-'a' + 26;
+    static const u8 Base64Invalid = 0xFFU;
+
+    /// 6 bit value of each base64 character, Base64Invalid for the others
+    static const u8 Base64Values[256] =
+    {
+        0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
+        0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
+        0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0x3E,0xFF,0xFF,0xFF,0x3F,
+        0x34,0x35,0x36,0x37,0x38,0x39,0x3A,0x3B,0x3C,0x3D,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
+        0xFF,0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0A,0x0B,0x0C,0x0D,0x0E,
+        0x0F,0x10,0x11,0x12,0x13,0x14,0x15,0x16,0x17,0x18,0x19,0xFF,0xFF,0xFF,0xFF,0xFF,
+        0xFF,0x1A,0x1B,0x1C,0x1D,0x1E,0x1F,0x20,0x21,0x22,0x23,0x24,0x25,0x26,0x27,0x28,
+        0x29,0x2A,0x2B,0x2C,0x2D,0x2E,0x2F,0x30,0x31,0x32,0x33,0xFF,0xFF,0xFF,0xFF,0xFF,
+        0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
+        0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
+        0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
+        0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
+        0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
+        0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
+        0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
+        0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,
+    };
 
-        }else if('0'<=c && c<='9'){
-            return c-'0' + 52;
+    /**
+    @brief Decode whole blocks of base64 characters, with SIMD if available.
+    SIMD versions classify characters with tables looked up by their nibbles,
+    then map them to 6 bit values by adding an offset per character range.
+    @return Number of characters consumed, a multiple of 4. It stops before a block which has an invalid character.
+    */
+    s32 decodeBase64Blocks(s32& d, u8* dst, s32 size, s32 length, const u8* src)
+    {
+        s32 i = 0;
+#ifdef CPPGLTF_AVX2
+        {
+            const __m256i lutLo = _mm256_setr_epi8(
+                0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+                0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+            const __m256i lutHi = _mm256_setr_epi8(
+                0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+                0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+            const __m256i lutRoll = _mm256_setr_epi8(
+                0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+                0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+            const __m256i nibble = _mm256_set1_epi8(0x0F);
+            const __m256i slash = _mm256_set1_epi8('/');
+            const __m256i zero = _mm256_setzero_si256();
+            const __m256i merge0 = _mm256_set1_epi32(0x01400140);
+            const __m256i merge1 = _mm256_set1_epi32(0x00011000);
+            const __m256i pack = _mm256_setr_epi8(
+                2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+            const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7);
+            //32 characters to 24 bytes, 32 bytes are stored
+            for(; i+32<=length && d+32<=size; i+=32){
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src+i));
+                __m256i hi = _mm256_and_si256(_mm256_srli_epi32(v, 4), nibble);
+                __m256i lo = _mm256_and_si256(v, nibble);
+                __m256i invalid = _mm256_and_si256(_mm256_shuffle_epi8(lutLo, lo), _mm256_shuffle_epi8(lutHi, hi));
+                if(0 != _mm256_movemask_epi8(_mm256_cmpgt_epi8(invalid, zero))){
+                    break;
+                }
+                __m256i roll = _mm256_shuffle_epi8(lutRoll, _mm256_add_epi8(_mm256_cmpeq_epi8(v, slash), hi));
+                v = _mm256_add_epi8(v, roll);
+                v = _mm256_madd_epi16(_mm256_maddubs_epi16(v, merge0), merge1);
+                v = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(v, pack), lanes);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst+d), v);
+                d += 24;
+            }
         }
-        for(s32 i=62; i<64; ++i){
-            if(Base64Chars[i]==c){
-                return i;
+#endif
+#ifdef CPPGLTF_SSSE3
+        {
+            const __m128i lutLo = _mm_setr_epi8(
+                0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+            const __m128i lutHi = _mm_setr_epi8(
+                0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+            const __m128i lutRoll = _mm_setr_epi8(
+                0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+            const __m128i nibble = _mm_set1_epi8(0x0F);
+            const __m128i slash = _mm_set1_epi8('/');
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i merge0 = _mm_set1_epi32(0x01400140);
+            const __m128i merge1 = _mm_set1_epi32(0x00011000);
+            const __m128i pack = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+            //16 characters to 12 bytes, 16 bytes are stored
+            for(; i+16<=length && d+16<=size; i+=16){
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src+i));
+                __m128i hi = _mm_and_si128(_mm_srli_epi32(v, 4), nibble);
+                __m128i lo = _mm_and_si128(v, nibble);
+                __m128i invalid = _mm_and_si128(_mm_shuffle_epi8(lutLo, lo), _mm_shuffle_epi8(lutHi, hi));
+                if(0 != _mm_movemask_epi8(_mm_cmpgt_epi8(invalid, zero))){
+                    break;
+                }
+                __m128i roll = _mm_shuffle_epi8(lutRoll, _mm_add_epi8(_mm_cmpeq_epi8(v, slash), hi));
+                v = _mm_add_epi8(v, roll);
+                v = _mm_madd_epi16(_mm_maddubs_epi16(v, merge0), merge1);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst+d), _mm_shuffle_epi8(v, pack));
+                d += 12;
             }
         }
-        return 0;
+#endif
+        for(; i+4<=length && d+3<=size; i+=4){
+            u32 v0 = Base64Values[src[i+0]];
+            u32 v1 = Base64Values[src[i+1]];
+            u32 v2 = Base64Values[src[i+2]];
+            u32 v3 = Base64Values[src[i+3]];
+            if(Base64Invalid == ((v0|v1|v2|v3)&Base64Invalid)){
+                break;
+            }
+            u32 v = (v0<<18) | (v1<<12) | (v2<<6) | v3;
+            dst[d+0] = static_cast<u8>(v>>16);
+            dst[d+1] = static_cast<u8>(v>>8);
+            dst[d+2] = static_cast<u8>(v);
+            d += 3;
+        }
+        return i;
     }
 }
 
     boolean isBase64(s32 c)
     {
-        return std::isalnum(c) || '+'==c || '/'==c;
+        return 0<=c && c<256 && Base64Invalid != Base64Values[c];
     }
 
     s32 getLengthEncodedBase64(s32 l)
@@ -2311,67 +3495,61 @@ namespace
         CPPGLTF_ASSERT(CPPGLTF_NULL != dst);
         CPPGLTF_ASSERT(CPPGLTF_NULL != file);
 
-        s32 l=0;
         s32 d=0;
-        u8 tmp[4];
-        while(!feof(file)){
+        u32 bits=0;
+        s32 numBits=0;
+        for(;;){
             s32 c = fgetc(file);
-            if(c<0||!isBase64(c) || Base64PadChar==c){
+            if(c<0 || Base64Invalid == Base64Values[c]){
                 break;
             }
-            tmp[l] =static_cast<u8>(getIndexBase64Chars(static_cast<s8>(c)));
-            ++l;
-            if(4<=l){
-                dst[d+0] = (tmp[0]<<2) | ((tmp[1]&0x30U)>>4);
-                dst[d+1] = ((tmp[1]&0x0FU)<<4) | ((tmp[2]&0x3CU)>>2);
-                dst[d+2] = ((tmp[2]&0x03U)<<6) | tmp[3];
-                d += 3;
-                l=0;
-            }
-        }
-        if(0<l){
-            for(s32 i=l; i<4; ++i){
-                tmp[i] = 0;
+            bits = (bits<<6) | Base64Values[c];
+            numBits += 6;
+            if(8<=numBits){
+                numBits -= 8;
+                dst[d] = static_cast<u8>(bits>>numBits);
+                bits &= (0x01U<<numBits)-1;
+                ++d;
             }
-            dst[d+0] = (tmp[0]<<2) | ((tmp[1]&0x30U)>>4);
-            dst[d+1] = ((tmp[1]&0x0FU)<<4) | ((tmp[2]&0x3CU)>>2);
-            dst[d+2] = ((tmp[2]&0x03U)<<6) | tmp[3];
-            d += (l*6)>>3;
         }
         return d;
     }
 
     s32 decodeBase64(u8* dst, s32 length, const s8* src)
+    {
+        return decodeBase64(dst, getLengthDecodedBase64(length), length, src);
+    }
+
+    s32 decodeBase64(u8* dst, s32 size, s32 length, const s8* src)
     {
         CPPGLTF_ASSERT(CPPGLTF_NULL != dst);
+        CPPGLTF_ASSERT(0<=size);
         CPPGLTF_ASSERT(0<=length);
         CPPGLTF_ASSERT(CPPGLTF_NULL != src);
 
-        s32 l=0;
+        const u8* usrc = reinterpret_cast<const u8*>(src);
         s32 d=0;
-        u8 tmp[4];
-        for(s32 i=0;
-            i<length && isBase64(src[i]) && Base64PadChar != src[i];
-            ++i)
-        {
-            tmp[l] = static_cast<u8>(getIndexBase64Chars(src[i]));
-            ++l;
-            if(4<=l){
-                dst[d+0] = (tmp[0]<<2) | ((tmp[1]&0x30U)>>4);
-                dst[d+1] = (tmp[1]<<4) | ((tmp[2]&0x3CU)>>2);
-                dst[d+2] = (tmp[2]<<6) | tmp[3];
-                d += 3;
-                l=0;
+        s32 i = decodeBase64Blocks(d, dst, size, length, usrc);
+
+        //The rest, a partial block, an invalid character or the end of dst
+        u32 bits=0;
+        s32 numBits=0;
+        for(; i<length; ++i){
+            u32 v = Base64Values[usrc[i]];
+            if(Base64Invalid == v){
+                break;
             }
-        }
-        if(0<l){
-            for(s32 i=l; i<4; ++i){
-                tmp[i] = 0;
+            bits = (bits<<6) | v;
+            numBits += 6;
+            if(8<=numBits){
+                if(size<=d){
+                    break;
+                }
+                numBits -= 8;
+                dst[d] = static_cast<u8>(bits>>numBits);
+                bits &= (0x01U<<numBits)-1;
+                ++d;
             }
-            dst[d+0] = (tmp[0]<<2) | ((tmp[1]&0x30U)>>4);
-            dst[d+1] = (tmp[1]<<4) | ((tmp[2]&0x3CU)>>2);
-            dst[d+2] = (tmp[2]<<6) | tmp[3];
-            d += (l*6)>>3;
         }
         return d;
     }
@@ -2507,6 +3685,292 @@ namespace
         return static_cast<u16>(round(x*65535.0f));
     }
 
+namespace
+{
+    template<class T> struct NormalizedTraits;
+    template<> struct NormalizedTraits<s8>
+    {
+        static const s32 Max = 127;
+        static const s32 Min = -127;
+        static inline s8 fromFloat(f32 x){ return toS8(x);}
+    };
+    template<> struct NormalizedTraits<u8>
+    {
+        static const s32 Max = 255;
+        static const s32 Min = 0;
+        static inline u8 fromFloat(f32 x){ return toU8(x);}
+    };
+    template<> struct NormalizedTraits<s16>
+    {
+        static const s32 Max = 32767;
+        static const s32 Min = -32767;
+        static inline s16 fromFloat(f32 x){ return toS16(x);}
+    };
+    template<> struct NormalizedTraits<u16>
+    {
+        static const s32 Max = 65535;
+        static const s32 Min = 0;
+        static inline u16 fromFloat(f32 x){ return toU16(x);}
+    };
+
+#ifdef CPPGLTF_AVX2
+    inline __m256i load8(const s8* src){ return _mm256_cvtepi8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src)));}
+    inline __m256i load8(const u8* src){ return _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src)));}
+    inline __m256i load8(const s16* src){ return _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src)));}
+    inline __m256i load8(const u16* src){ return _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src)));}
+#endif
+
+#ifdef CPPGLTF_SSE2
+    inline __m128i load4(const s8* src)
+    {
+        s32 x;
+        ::memcpy(&x, src, sizeof(s32));
+        __m128i v = _mm_cvtsi32_si128(x);
+        v = _mm_unpacklo_epi8(v, v);
+        return _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 24);
+    }
+
+    inline __m128i load4(const u8* src)
+    {
+        s32 x;
+        ::memcpy(&x, src, sizeof(s32));
+        const __m128i zero = _mm_setzero_si128();
+        return _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(x), zero), zero);
+    }
+
+    inline __m128i load4(const s16* src)
+    {
+        __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src));
+        return _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+    }
+
+    inline __m128i load4(const u16* src)
+    {
+        return _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src)), _mm_setzero_si128());
+    }
+
+    inline void store4(s8* dst, __m128i x)
+    {
+        x = _mm_packs_epi32(x, x);
+        s32 v = _mm_cvtsi128_si32(_mm_packs_epi16(x, x));
+        ::memcpy(dst, &v, sizeof(s32));
+    }
+
+    inline void store4(u8* dst, __m128i x)
+    {
+        x = _mm_packs_epi32(x, x);
+        s32 v = _mm_cvtsi128_si32(_mm_packus_epi16(x, x));
+        ::memcpy(dst, &v, sizeof(s32));
+    }
+
+    inline void store4(s16* dst, __m128i x)
+    {
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), _mm_packs_epi32(x, x));
+    }
+
+    /**
+    @brief Pack 8 of 32 bits into unsigned 16 bits with saturation
+    */
+    inline __m128i packU16(__m128i x0, __m128i x1)
+    {
+        //No unsigned saturation of 32 bits in SSE2, so pack around the middle of the range
+        const __m128i middle = _mm_set1_epi32(32768);
+        __m128i x = _mm_packs_epi32(_mm_sub_epi32(x0, middle), _mm_sub_epi32(x1, middle));
+        return _mm_xor_si128(x, _mm_set1_epi16(-32768));
+    }
+
+    inline void store4(u16* dst, __m128i x)
+    {
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), packU16(x, x));
+    }
+
+    /**
+    @brief Round half away from zero the same as round, of which SIMD has only half to even
+    */
+    inline __m128i roundHalfAway(__m128 x)
+    {
+        __m128i t = _mm_cvttps_epi32(x);
+        __m128 fraction = _mm_sub_ps(x, _mm_cvtepi32_ps(t));
+        __m128i up = _mm_castps_si128(_mm_cmpge_ps(fraction, _mm_set1_ps(0.5f)));
+        __m128i down = _mm_castps_si128(_mm_cmple_ps(fraction, _mm_set1_ps(-0.5f)));
+        return _mm_add_epi32(_mm_sub_epi32(t, up), down);
+    }
+#endif
+
+    template<class T>
+    void toFloatPacked(f32* dst, s32 size, const T* src)
+    {
+        const f32 max = static_cast<f32>(NormalizedTraits<T>::Max);
+        const f32 lower = (0<=NormalizedTraits<T>::Min)? 0.0f : -1.0f;
+        s32 i = 0;
+#ifdef CPPGLTF_AVX2
+        {
+            const __m256 scale = _mm256_set1_ps(max);
+            const __m256 minimum = _mm256_set1_ps(lower);
+            for(; i+8<=size; i+=8){
+                __m256 x = _mm256_div_ps(_mm256_cvtepi32_ps(load8(src+i)), scale);
+                _mm256_storeu_ps(dst+i, _mm256_max_ps(x, minimum));
+            }
+        }
+#endif
+#ifdef CPPGLTF_SSE2
+        {
+            const __m128 scale = _mm_set1_ps(max);
+            const __m128 minimum = _mm_set1_ps(lower);
+            for(; i+4<=size; i+=4){
+                __m128 x = _mm_div_ps(_mm_cvtepi32_ps(load4(src+i)), scale);
+                _mm_storeu_ps(dst+i, _mm_max_ps(x, minimum));
+            }
+        }
+#endif
+        for(; i<size; ++i){
+            dst[i] = toFloat(src[i]);
+        }
+    }
+
+    template<class T>
+    void fromFloatPacked(T* dst, s32 size, const f32* src)
+    {
+        const f32 max = static_cast<f32>(NormalizedTraits<T>::Max);
+        const f32 lower = (0<=NormalizedTraits<T>::Min)? 0.0f : -1.0f;
+        s32 i = 0;
+#ifdef CPPGLTF_SSE2
+        {
+            const __m128 scale = _mm_set1_ps(max);
+            const __m128 minimum = _mm_set1_ps(lower);
+            const __m128 one = _mm_set1_ps(1.0f);
+            for(; i+4<=size; i+=4){
+                __m128 x = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src+i), minimum), one);
+                store4(dst+i, roundHalfAway(_mm_mul_ps(x, scale)));
+            }
+        }
+#endif
+        for(; i<size; ++i){
+            f32 x = src[i];
+            x = (x<lower)? lower : x;
+            x = (1.0f<x)? 1.0f : x;
+            dst[i] = NormalizedTraits<T>::fromFloat(x);
+        }
+    }
+
+    template<s32 N>
+    inline void copyElements(u8* dst, s32 dstStride, const u8* src, s32 srcStride, s32 count)
+    {
+        for(s32 i=0; i<count; ++i){
+            ::memcpy(dst, src, N);
+            dst += dstStride;
+            src += srcStride;
+        }
+    }
+
+    /**
+    @brief Copy elements between strides, with fixed sizes for common elements
+    */
+    void copyElements(u8* dst, s32 dstStride, const u8* src, s32 srcStride, s32 count, s32 size)
+    {
+        switch(size){
+        case 1: copyElements<1>(dst, dstStride, src, srcStride, count); break;
+        case 2: copyElements<2>(dst, dstStride, src, srcStride, count); break;
+        case 3: copyElements<3>(dst, dstStride, src, srcStride, count); break;
+        case 4: copyElements<4>(dst, dstStride, src, srcStride, count); break;
+        case 6: copyElements<6>(dst, dstStride, src, srcStride, count); break;
+        case 8: copyElements<8>(dst, dstStride, src, srcStride, count); break;
+        case 12: copyElements<12>(dst, dstStride, src, srcStride, count); break;
+        case 16: copyElements<16>(dst, dstStride, src, srcStride, count); break;
+        default:
+            for(s32 i=0; i<count; ++i){
+                ::memcpy(dst, src, size);
+                dst += dstStride;
+                src += srcStride;
+            }
+            break;
+        }
+    }
+
+    /// Strided elements are gathered into or scattered from a block of this size, to be converted packed
+    static const s32 ConvertBlockSize = 4096;
+
+    template<class T>
+    void toFloatStrided(f32* dst, s32 numComponents, s32 count, s32 srcStride, const u8* src)
+    {
+        s32 elementSize = numComponents*static_cast<s32>(sizeof(T));
+        if(srcStride<=0 || srcStride == elementSize){
+            toFloatPacked(dst, numComponents*count, reinterpret_cast<const T*>(src));
+            return;
+        }
+        T block[ConvertBlockSize/sizeof(T)];
+        s32 blockCount = ConvertBlockSize/elementSize;
+        for(s32 i=0; i<count; i+=blockCount){
+            s32 n = (count-i<blockCount)? count-i : blockCount;
+            copyElements(reinterpret_cast<u8*>(block), elementSize, src + static_cast<s64>(srcStride)*i, srcStride, n, elementSize);
+            toFloatPacked(dst + static_cast<s64>(numComponents)*i, numComponents*n, block);
+        }
+    }
+
+    template<class T>
+    void fromFloatStrided(u8* dst, s32 numComponents, s32 count, s32 dstStride, const f32* src)
+    {
+        s32 elementSize = numComponents*static_cast<s32>(sizeof(T));
+        if(dstStride<=0 || dstStride == elementSize){
+            fromFloatPacked(reinterpret_cast<T*>(dst), numComponents*count, src);
+            return;
+        }
+        T block[ConvertBlockSize/sizeof(T)];
+        s32 blockCount = ConvertBlockSize/elementSize;
+        for(s32 i=0; i<count; i+=blockCount){
+            s32 n = (count-i<blockCount)? count-i : blockCount;
+            fromFloatPacked(block, numComponents*n, src + static_cast<s64>(numComponents)*i);
+            copyElements(dst + static_cast<s64>(dstStride)*i, dstStride, reinterpret_cast<const u8*>(block), elementSize, n, elementSize);
+        }
+    }
+}
+
+    boolean toFloat(f32* dst, s32 componentType, s32 numComponents, s32 count, s32 srcStride, const void* src)
+    {
+        CPPGLTF_ASSERT(0<numComponents && numComponents*2<=ConvertBlockSize);
+        CPPGLTF_ASSERT(0==count || (CPPGLTF_NULL != dst && CPPGLTF_NULL != src));
+        const u8* bytes = reinterpret_cast<const u8*>(src);
+        switch(componentType){
+        case GLTF_TYPE_BYTE:
+            toFloatStrided<s8>(dst, numComponents, count, srcStride, bytes);
+            return true;
+        case GLTF_TYPE_UNSIGNED_BYTE:
+            toFloatStrided<u8>(dst, numComponents, count, srcStride, bytes);
+            return true;
+        case GLTF_TYPE_SHORT:
+            toFloatStrided<s16>(dst, numComponents, count, srcStride, bytes);
+            return true;
+        case GLTF_TYPE_UNSIGNED_SHORT:
+            toFloatStrided<u16>(dst, numComponents, count, srcStride, bytes);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    boolean fromFloat(void* dst, s32 componentType, s32 numComponents, s32 count, s32 dstStride, const f32* src)
+    {
+        CPPGLTF_ASSERT(0<numComponents && numComponents*2<=ConvertBlockSize);
+        CPPGLTF_ASSERT(0==count || (CPPGLTF_NULL != dst && CPPGLTF_NULL != src));
+        u8* bytes = reinterpret_cast<u8*>(dst);
+        switch(componentType){
+        case GLTF_TYPE_BYTE:
+            fromFloatStrided<s8>(bytes, numComponents, count, dstStride, src);
+            return true;
+        case GLTF_TYPE_UNSIGNED_BYTE:
+            fromFloatStrided<u8>(bytes, numComponents, count, dstStride, src);
+            return true;
+        case GLTF_TYPE_SHORT:
+            fromFloatStrided<s16>(bytes, numComponents, count, dstStride, src);
+            return true;
+        case GLTF_TYPE_UNSIGNED_SHORT:
+            fromFloatStrided<u16>(bytes, numComponents, count, dstStride, src);
+            return true;
+        default:
+            return false;
+        }
+    }
+
     //--------------------------------------------
     //---
     //--- String
@@ -2697,7 +4161,7 @@ namespace
                 return false;
             }
         }
-        return false;
+        return '\0' == str[length()];
     }
 
     boolean operator==(const String& lhs, const Char* rhs)
@@ -2769,7 +4233,7 @@ namespace
 
     boolean ISStream::seek(off_t pos)
     {
-        CPPGLTF_ASSERT(0<=pos && pos<length_);
+        CPPGLTF_ASSERT(0<=pos && pos<=length_);
         pos_ = pos;
         return true;
     }
@@ -2792,17 +4256,15 @@ namespace
         return c;
     }
 
-    s32 ISStream::read(u8* dst, s32 size)
+    s32 ISStream::read(u8* dst, s64 size)
     {
         CPPGLTF_ASSERT(CPPGLTF_NULL != dst);
         off_t end = pos_+size;
         if(length_<end){
             return 0;
         }
-        for(s32 i=0; i<size; ++i){
-            dst[i] = str_[pos_];
-            ++pos_;
-        }
+        ::memcpy(dst, str_+pos_, static_cast<size_type>(size));
+        pos_ = end;
         return 1;
     }
 
@@ -2811,6 +4273,16 @@ namespace
         return length_<=pos_;
     }
 
+    s64 ISStream::size() const
+    {
+        return length_;
+    }
+
+    const u8* ISStream::data() const
+    {
+        return str_;
+    }
+
     ISStream& ISStream::operator=(ISStream&& rhs)
     {
         if(this == &rhs){
@@ -2828,19 +4300,176 @@ namespace
 
     //---------------------------------------------------------------
     //---
-    //--- IFStream
+    //--- IMMStream
     //---
     //---------------------------------------------------------------
-    IFStream::IFStream()
-        :pos_(0)
+namespace
+{
+    /// Largest size passed to fread or fwrite at once, which is safe for 32 bit size_t and CRTs
+    static const s64 MaxIOChunk = 64*1024*1024;
+
+    boolean readChunked(FILE* file, u8* dst, s64 size)
     {
+        while(0<size){
+            size_type chunk = static_cast<size_type>(size<MaxIOChunk? size : MaxIOChunk);
+            if(fread(dst, chunk, 1, file)<=0){
+                return false;
+            }
+            dst += chunk;
+            size -= chunk;
+        }
+        return true;
     }
 
-    IFStream::IFStream(IFStream&& rhs)
-        :parent_type(std::move(rhs))
-        ,pos_(rhs.pos_)
+    boolean writeChunked(FILE* file, const u8* src, s64 size)
     {
-        rhs.pos_ = 0;
+        while(0<size){
+            size_type chunk = static_cast<size_type>(size<MaxIOChunk? size : MaxIOChunk);
+            if(fwrite(src, chunk, 1, file)<=0){
+                return false;
+            }
+            src += chunk;
+            size -= chunk;
+        }
+        return true;
+    }
+
+    /**
+    @brief Map a whole file copy-on-write, or read it into memory where mmap is not available
+    @return false if failed. data is NULL for an empty file.
+    */
+    boolean mapFile(u8*& data, s64& length, const Char* filepath)
+    {
+        data = CPPGLTF_NULL;
+        length = 0;
+#ifdef _MSC_VER
+        FILE* file = CPPGLTF_FOPEN(filepath, "rb");
+        if(CPPGLTF_NULL == file){
+            return false;
+        }
+        s64 size = CPPGLTF_FSIZE(file);
+        if(0<size){
+            data = (u8*)CPPGLTF_MALLOC(static_cast<size_type>(size));
+            if(!readChunked(file, data, size)){
+                CPPGLTF_FREE(data);
+                data = CPPGLTF_NULL;
+                CPPGLTF_FCLOSE(file);
+                return false;
+            }
+        }
+        CPPGLTF_FCLOSE(file);
+#else
+        s32 fd = ::open(filepath, O_RDONLY);
+        if(fd<0){
+            return false;
+        }
+        struct stat st;
+        if(0 != ::fstat(fd, &st)){
+            ::close(fd);
+            return false;
+        }
+        s64 size = st.st_size;
+        if(0<size){
+            //Writes through the pages are private and never reach the file
+            void* map = ::mmap(CPPGLTF_NULL, static_cast<size_type>(size), PROT_READ|PROT_WRITE, MAP_PRIVATE, fd, 0);
+            if(MAP_FAILED == map){
+                ::close(fd);
+                return false;
+            }
+            data = reinterpret_cast<u8*>(map);
+        }
+        ::close(fd);
+#endif
+        length = size;
+        return true;
+    }
+
+    void unmapFile(u8* data, s64 length)
+    {
+        if(CPPGLTF_NULL == data){
+            return;
+        }
+#ifdef _MSC_VER
+        (void)length;
+        CPPGLTF_FREE(data);
+#else
+        ::munmap(data, static_cast<size_type>(length));
+#endif
+    }
+}
+
+    IMMStream::IMMStream()
+    {
+    }
+
+    IMMStream::IMMStream(IMMStream&& rhs)
+        :ISStream(std::move(rhs))
+    {
+    }
+
+    IMMStream::~IMMStream()
+    {
+        close();
+    }
+
+    bool IMMStream::open(const Char* filepath)
+    {
+        CPPGLTF_ASSERT(CPPGLTF_NULL != filepath);
+        close();
+        u8* str;
+        s64 length;
+        if(!mapFile(str, length, filepath)){
+            return false;
+        }
+#ifndef _MSC_VER
+        if(CPPGLTF_NULL != str){
+            ::madvise(str, static_cast<size_type>(length), MADV_SEQUENTIAL);
+        }
+#endif
+        pos_ = 0;
+        length_ = length;
+        str_ = str;
+        return true;
+    }
+
+    void IMMStream::close()
+    {
+        unmapFile(const_cast<u8*>(str_), length_);
+        pos_ = 0;
+        length_ = 0;
+        str_ = CPPGLTF_NULL;
+    }
+
+    bool IMMStream::valid() const
+    {
+        return CPPGLTF_NULL != str_;
+    }
+
+    IMMStream& IMMStream::operator=(IMMStream&& rhs)
+    {
+        if(this == &rhs){
+            return *this;
+        }
+        close();
+        ISStream::operator=(std::move(rhs));
+        return *this;
+    }
+
+    //---------------------------------------------------------------
+    //---
+    //--- IFStream
+    //---
+    //---------------------------------------------------------------
+    IFStream::IFStream()
+        :pos_(0)
+    {
+    }
+
+    IFStream::IFStream(IFStream&& rhs)
+        :parent_type(std::move(rhs))
+        ,pos_(rhs.pos_)
+    {
+        rhs.pos_ = 0;
     }
 
     IFStream::~IFStream()
@@ -2882,10 +4511,10 @@ namespace
         return ungetc(c, file_);
     }
 
-    s32 IFStream::read(u8* dst, s32 size)
+    s32 IFStream::read(u8* dst, s64 size)
     {
         CPPGLTF_ASSERT(CPPGLTF_NULL != dst);
-        return static_cast<s32>(fread(dst, size, 1, file_));
+        return readChunked(file_, dst, size)? 1 : 0;
     }
 
     boolean IFStream::isEOF() const
@@ -3063,6 +4692,879 @@ namespace
         return *this;
     }
 
+namespace
+{
+    //Truncated 128 bit mantissas of 10^q, q in [-342, 308], {high, low}
+    static const s32 Pow10MinExponent = -342;
+    static const s32 Pow10MaxExponent = 308;
+    static const u64 Pow10Mantissa128[][2] =
+    {
+        {0xEEF453D6923BD65AULL, 0x113FAA2906A13B3FULL},
+        {0x9558B4661B6565F8ULL, 0x4AC7CA59A424C507ULL},
+        {0xBAAEE17FA23EBF76ULL, 0x5D79BCF00D2DF649ULL},
+        {0xE95A99DF8ACE6F53ULL, 0xF4D82C2C107973DCULL},
+        {0x91D8A02BB6C10594ULL, 0x79071B9B8A4BE869ULL},
+        {0xB64EC836A47146F9ULL, 0x9748E2826CDEE284ULL},
+        {0xE3E27A444D8D98B7ULL, 0xFD1B1B2308169B25ULL},
+        {0x8E6D8C6AB0787F72ULL, 0xFE30F0F5E50E20F7ULL},
+        {0xB208EF855C969F4FULL, 0xBDBD2D335E51A935ULL},
+        {0xDE8B2B66B3BC4723ULL, 0xAD2C788035E61382ULL},
+        {0x8B16FB203055AC76ULL, 0x4C3BCB5021AFCC31ULL},
+        {0xADDCB9E83C6B1793ULL, 0xDF4ABE242A1BBF3DULL},
+        {0xD953E8624B85DD78ULL, 0xD71D6DAD34A2AF0DULL},
+        {0x87D4713D6F33AA6BULL, 0x8672648C40E5AD68ULL},
+        {0xA9C98D8CCB009506ULL, 0x680EFDAF511F18C2ULL},
+        {0xD43BF0EFFDC0BA48ULL, 0x0212BD1B2566DEF2ULL},
+        {0x84A57695FE98746DULL, 0x014BB630F7604B57ULL},
+        {0xA5CED43B7E3E9188ULL, 0x419EA3BD35385E2DULL},
+        {0xCF42894A5DCE35EAULL, 0x52064CAC828675B9ULL},
+        {0x818995CE7AA0E1B2ULL, 0x7343EFEBD1940993ULL},
+        {0xA1EBFB4219491A1FULL, 0x1014EBE6C5F90BF8ULL},
+        {0xCA66FA129F9B60A6ULL, 0xD41A26E077774EF6ULL},
+        {0xFD00B897478238D0ULL, 0x8920B098955522B4ULL},
+        {0x9E20735E8CB16382ULL, 0x55B46E5F5D5535B0ULL},
+        {0xC5A890362FDDBC62ULL, 0xEB2189F734AA831DULL},
+        {0xF712B443BBD52B7BULL, 0xA5E9EC7501D523E4ULL},
+        {0x9A6BB0AA55653B2DULL, 0x47B233C92125366EULL},
+        {0xC1069CD4EABE89F8ULL, 0x999EC0BB696E840AULL},
+        {0xF148440A256E2C76ULL, 0xC00670EA43CA250DULL},
+        {0x96CD2A865764DBCAULL, 0x380406926A5E5728ULL},
+        {0xBC807527ED3E12BCULL, 0xC605083704F5ECF2ULL},
+        {0xEBA09271E88D976BULL, 0xF7864A44C633682EULL},
+        {0x93445B8731587EA3ULL, 0x7AB3EE6AFBE0211DULL},
+        {0xB8157268FDAE9E4CULL, 0x5960EA05BAD82964ULL},
+        {0xE61ACF033D1A45DFULL, 0x6FB92487298E33BDULL},
+        {0x8FD0C16206306BABULL, 0xA5D3B6D479F8E056ULL},
+        {0xB3C4F1BA87BC8696ULL, 0x8F48A4899877186CULL},
+        {0xE0B62E2929ABA83CULL, 0x331ACDABFE94DE87ULL},
+        {0x8C71DCD9BA0B4925ULL, 0x9FF0C08B7F1D0B14ULL},
+        {0xAF8E5410288E1B6FULL, 0x07ECF0AE5EE44DD9ULL},
+        {0xDB71E91432B1A24AULL, 0xC9E82CD9F69D6150ULL},
+        {0x892731AC9FAF056EULL, 0xBE311C083A225CD2ULL},
+        {0xAB70FE17C79AC6CAULL, 0x6DBD630A48AAF406ULL},
+        {0xD64D3D9DB981787DULL, 0x092CBBCCDAD5B108ULL},
+        {0x85F0468293F0EB4EULL, 0x25BBF56008C58EA5ULL},
+        {0xA76C582338ED2621ULL, 0xAF2AF2B80AF6F24EULL},
+        {0xD1476E2C07286FAAULL, 0x1AF5AF660DB4AEE1ULL},
+        {0x82CCA4DB847945CAULL, 0x50D98D9FC890ED4DULL},
+        {0xA37FCE126597973CULL, 0xE50FF107BAB528A0ULL},
+        {0xCC5FC196FEFD7D0CULL, 0x1E53ED49A96272C8ULL},
+        {0xFF77B1FCBEBCDC4FULL, 0x25E8E89C13BB0F7AULL},
+        {0x9FAACF3DF73609B1ULL, 0x77B191618C54E9ACULL},
+        {0xC795830D75038C1DULL, 0xD59DF5B9EF6A2417ULL},
+        {0xF97AE3D0D2446F25ULL, 0x4B0573286B44AD1DULL},
+        {0x9BECCE62836AC577ULL, 0x4EE367F9430AEC32ULL},
+        {0xC2E801FB244576D5ULL, 0x229C41F793CDA73FULL},
+        {0xF3A20279ED56D48AULL, 0x6B43527578C1110FULL},
+        {0x9845418C345644D6ULL, 0x830A13896B78AAA9ULL},
+        {0xBE5691EF416BD60CULL, 0x23CC986BC656D553ULL},
+        {0xEDEC366B11C6CB8FULL, 0x2CBFBE86B7EC8AA8ULL},
+        {0x94B3A202EB1C3F39ULL, 0x7BF7D71432F3D6A9ULL},
+        {0xB9E08A83A5E34F07ULL, 0xDAF5CCD93FB0CC53ULL},
+        {0xE858AD248F5C22C9ULL, 0xD1B3400F8F9CFF68ULL},
+        {0x91376C36D99995BEULL, 0x23100809B9C21FA1ULL},
+        {0xB58547448FFFFB2DULL, 0xABD40A0C2832A78AULL},
+        {0xE2E69915B3FFF9F9ULL, 0x16C90C8F323F516CULL},
+        {0x8DD01FAD907FFC3BULL, 0xAE3DA7D97F6792E3ULL},
+        {0xB1442798F49FFB4AULL, 0x99CD11CFDF41779CULL},
+        {0xDD95317F31C7FA1DULL, 0x40405643D711D583ULL},
+        {0x8A7D3EEF7F1CFC52ULL, 0x482835EA666B2572ULL},
+        {0xAD1C8EAB5EE43B66ULL, 0xDA3243650005EECFULL},
+        {0xD863B256369D4A40ULL, 0x90BED43E40076A82ULL},
+        {0x873E4F75E2224E68ULL, 0x5A7744A6E804A291ULL},
+        {0xA90DE3535AAAE202ULL, 0x711515D0A205CB36ULL},
+        {0xD3515C2831559A83ULL, 0x0D5A5B44CA873E03ULL},
+        {0x8412D9991ED58091ULL, 0xE858790AFE9486C2ULL},
+        {0xA5178FFF668AE0B6ULL, 0x626E974DBE39A872ULL},
+        {0xCE5D73FF402D98E3ULL, 0xFB0A3D212DC8128FULL},
+        {0x80FA687F881C7F8EULL, 0x7CE66634BC9D0B99ULL},
+        {0xA139029F6A239F72ULL, 0x1C1FFFC1EBC44E80ULL},
+        {0xC987434744AC874EULL, 0xA327FFB266B56220ULL},
+        {0xFBE9141915D7A922ULL, 0x4BF1FF9F0062BAA8ULL},
+        {0x9D71AC8FADA6C9B5ULL, 0x6F773FC3603DB4A9ULL},
+        {0xC4CE17B399107C22ULL, 0xCB550FB4384D21D3ULL},
+        {0xF6019DA07F549B2BULL, 0x7E2A53A146606A48ULL},
+        {0x99C102844F94E0FBULL, 0x2EDA7444CBFC426DULL},
+        {0xC0314325637A1939ULL, 0xFA911155FEFB5308ULL},
+        {0xF03D93EEBC589F88ULL, 0x793555AB7EBA27CAULL},
+        {0x96267C7535B763B5ULL, 0x4BC1558B2F3458DEULL},
+        {0xBBB01B9283253CA2ULL, 0x9EB1AAEDFB016F16ULL},
+        {0xEA9C227723EE8BCBULL, 0x465E15A979C1CADCULL},
+        {0x92A1958A7675175FULL, 0x0BFACD89EC191EC9ULL},
+        {0xB749FAED14125D36ULL, 0xCEF980EC671F667BULL},
+        {0xE51C79A85916F484ULL, 0x82B7E12780E7401AULL},
+        {0x8F31CC0937AE58D2ULL, 0xD1B2ECB8B0908810ULL},
+        {0xB2FE3F0B8599EF07ULL, 0x861FA7E6DCB4AA15ULL},
+        {0xDFBDCECE67006AC9ULL, 0x67A791E093E1D49AULL},
+        {0x8BD6A141006042BDULL, 0xE0C8BB2C5C6D24E0ULL},
+        {0xAECC49914078536DULL, 0x58FAE9F773886E18ULL},
+        {0xDA7F5BF590966848ULL, 0xAF39A475506A899EULL},
+        {0x888F99797A5E012DULL, 0x6D8406C952429603ULL},
+        {0xAAB37FD7D8F58178ULL, 0xC8E5087BA6D33B83ULL},
+        {0xD5605FCDCF32E1D6ULL, 0xFB1E4A9A90880A64ULL},
+        {0x855C3BE0A17FCD26ULL, 0x5CF2EEA09A55067FULL},
+        {0xA6B34AD8C9DFC06FULL, 0xF42FAA48C0EA481EULL},
+        {0xD0601D8EFC57B08BULL, 0xF13B94DAF124DA26ULL},
+        {0x823C12795DB6CE57ULL, 0x76C53D08D6B70858ULL},
+        {0xA2CB1717B52481EDULL, 0x54768C4B0C64CA6EULL},
+        {0xCB7DDCDDA26DA268ULL, 0xA9942F5DCF7DFD09ULL},
+        {0xFE5D54150B090B02ULL, 0xD3F93B35435D7C4CULL},
+        {0x9EFA548D26E5A6E1ULL, 0xC47BC5014A1A6DAFULL},
+        {0xC6B8E9B0709F109AULL, 0x359AB6419CA1091BULL},
+        {0xF867241C8CC6D4C0ULL, 0xC30163D203C94B62ULL},
+        {0x9B407691D7FC44F8ULL, 0x79E0DE63425DCF1DULL},
+        {0xC21094364DFB5636ULL, 0x985915FC12F542E4ULL},
+        {0xF294B943E17A2BC4ULL, 0x3E6F5B7B17B2939DULL},
+        {0x979CF3CA6CEC5B5AULL, 0xA705992CEECF9C42ULL},
+        {0xBD8430BD08277231ULL, 0x50C6FF782A838353ULL},
+        {0xECE53CEC4A314EBDULL, 0xA4F8BF5635246428ULL},
+        {0x940F4613AE5ED136ULL, 0x871B7795E136BE99ULL},
+        {0xB913179899F68584ULL, 0x28E2557B59846E3FULL},
+        {0xE757DD7EC07426E5ULL, 0x331AEADA2FE589CFULL},
+        {0x9096EA6F3848984FULL, 0x3FF0D2C85DEF7621ULL},
+        {0xB4BCA50B065ABE63ULL, 0x0FED077A756B53A9ULL},
+        {0xE1EBCE4DC7F16DFBULL, 0xD3E8495912C62894ULL},
+        {0x8D3360F09CF6E4BDULL, 0x64712DD7ABBBD95CULL},
+        {0xB080392CC4349DECULL, 0xBD8D794D96AACFB3ULL},
+        {0xDCA04777F541C567ULL, 0xECF0D7A0FC5583A0ULL},
+        {0x89E42CAAF9491B60ULL, 0xF41686C49DB57244ULL},
+        {0xAC5D37D5B79B6239ULL, 0x311C2875C522CED5ULL},
+        {0xD77485CB25823AC7ULL, 0x7D633293366B828BULL},
+        {0x86A8D39EF77164BCULL, 0xAE5DFF9C02033197ULL},
+        {0xA8530886B54DBDEBULL, 0xD9F57F830283FDFCULL},
+        {0xD267CAA862A12D66ULL, 0xD072DF63C324FD7BULL},
+        {0x8380DEA93DA4BC60ULL, 0x4247CB9E59F71E6DULL},
+        {0xA46116538D0DEB78ULL, 0x52D9BE85F074E608ULL},
+        {0xCD795BE870516656ULL, 0x67902E276C921F8BULL},
+        {0x806BD9714632DFF6ULL, 0x00BA1CD8A3DB53B6ULL},
+        {0xA086CFCD97BF97F3ULL, 0x80E8A40ECCD228A4ULL},
+        {0xC8A883C0FDAF7DF0ULL, 0x6122CD128006B2CDULL},
+        {0xFAD2A4B13D1B5D6CULL, 0x796B805720085F81ULL},
+        {0x9CC3A6EEC6311A63ULL, 0xCBE3303674053BB0ULL},
+        {0xC3F490AA77BD60FCULL, 0xBEDBFC4411068A9CULL},
+        {0xF4F1B4D515ACB93BULL, 0xEE92FB5515482D44ULL},
+        {0x991711052D8BF3C5ULL, 0x751BDD152D4D1C4AULL},
+        {0xBF5CD54678EEF0B6ULL, 0xD262D45A78A0635DULL},
+        {0xEF340A98172AACE4ULL, 0x86FB897116C87C34ULL},
+        {0x9580869F0E7AAC0EULL, 0xD45D35E6AE3D4DA0ULL},
+        {0xBAE0A846D2195712ULL, 0x8974836059CCA109ULL},
+        {0xE998D258869FACD7ULL, 0x2BD1A438703FC94BULL},
+        {0x91FF83775423CC06ULL, 0x7B6306A34627DDCFULL},
+        {0xB67F6455292CBF08ULL, 0x1A3BC84C17B1D542ULL},
+        {0xE41F3D6A7377EECAULL, 0x20CABA5F1D9E4A93ULL},
+        {0x8E938662882AF53EULL, 0x547EB47B7282EE9CULL},
+        {0xB23867FB2A35B28DULL, 0xE99E619A4F23AA43ULL},
+        {0xDEC681F9F4C31F31ULL, 0x6405FA00E2EC94D4ULL},
+        {0x8B3C113C38F9F37EULL, 0xDE83BC408DD3DD04ULL},
+        {0xAE0B158B4738705EULL, 0x9624AB50B148D445ULL},
+        {0xD98DDAEE19068C76ULL, 0x3BADD624DD9B0957ULL},
+        {0x87F8A8D4CFA417C9ULL, 0xE54CA5D70A80E5D6ULL},
+        {0xA9F6D30A038D1DBCULL, 0x5E9FCF4CCD211F4CULL},
+        {0xD47487CC8470652BULL, 0x7647C3200069671FULL},
+        {0x84C8D4DFD2C63F3BULL, 0x29ECD9F40041E073ULL},
+        {0xA5FB0A17C777CF09ULL, 0xF468107100525890ULL},
+        {0xCF79CC9DB955C2CCULL, 0x7182148D4066EEB4ULL},
+        {0x81AC1FE293D599BFULL, 0xC6F14CD848405530ULL},
+        {0xA21727DB38CB002FULL, 0xB8ADA00E5A506A7CULL},
+        {0xCA9CF1D206FDC03BULL, 0xA6D90811F0E4851CULL},
+        {0xFD442E4688BD304AULL, 0x908F4A166D1DA663ULL},
+        {0x9E4A9CEC15763E2EULL, 0x9A598E4E043287FEULL},
+        {0xC5DD44271AD3CDBAULL, 0x40EFF1E1853F29FDULL},
+        {0xF7549530E188C128ULL, 0xD12BEE59E68EF47CULL},
+        {0x9A94DD3E8CF578B9ULL, 0x82BB74F8301958CEULL},
+        {0xC13A148E3032D6E7ULL, 0xE36A52363C1FAF01ULL},
+        {0xF18899B1BC3F8CA1ULL, 0xDC44E6C3CB279AC1ULL},
+        {0x96F5600F15A7B7E5ULL, 0x29AB103A5EF8C0B9ULL},
+        {0xBCB2B812DB11A5DEULL, 0x7415D448F6B6F0E7ULL},
+        {0xEBDF661791D60F56ULL, 0x111B495B3464AD21ULL},
+        {0x936B9FCEBB25C995ULL, 0xCAB10DD900BEEC34ULL},
+        {0xB84687C269EF3BFBULL, 0x3D5D514F40EEA742ULL},
+        {0xE65829B3046B0AFAULL, 0x0CB4A5A3112A5112ULL},
+        {0x8FF71A0FE2C2E6DCULL, 0x47F0E785EABA72ABULL},
+        {0xB3F4E093DB73A093ULL, 0x59ED216765690F56ULL},
+        {0xE0F218B8D25088B8ULL, 0x306869C13EC3532CULL},
+        {0x8C974F7383725573ULL, 0x1E414218C73A13FBULL},
+        {0xAFBD2350644EEACFULL, 0xE5D1929EF90898FAULL},
+        {0xDBAC6C247D62A583ULL, 0xDF45F746B74ABF39ULL},
+        {0x894BC396CE5DA772ULL, 0x6B8BBA8C328EB783ULL},
+        {0xAB9EB47C81F5114FULL, 0x066EA92F3F326564ULL},
+        {0xD686619BA27255A2ULL, 0xC80A537B0EFEFEBDULL},
+        {0x8613FD0145877585ULL, 0xBD06742CE95F5F36ULL},
+        {0xA798FC4196E952E7ULL, 0x2C48113823B73704ULL},
+        {0xD17F3B51FCA3A7A0ULL, 0xF75A15862CA504C5ULL},
+        {0x82EF85133DE648C4ULL, 0x9A984D73DBE722FBULL},
+        {0xA3AB66580D5FDAF5ULL, 0xC13E60D0D2E0EBBAULL},
+        {0xCC963FEE10B7D1B3ULL, 0x318DF905079926A8ULL},
+        {0xFFBBCFE994E5C61FULL, 0xFDF17746497F7052ULL},
+        {0x9FD561F1FD0F9BD3ULL, 0xFEB6EA8BEDEFA633ULL},
+        {0xC7CABA6E7C5382C8ULL, 0xFE64A52EE96B8FC0ULL},
+        {0xF9BD690A1B68637BULL, 0x3DFDCE7AA3C673B0ULL},
+        {0x9C1661A651213E2DULL, 0x06BEA10CA65C084EULL},
+        {0xC31BFA0FE5698DB8ULL, 0x486E494FCFF30A62ULL},
+        {0xF3E2F893DEC3F126ULL, 0x5A89DBA3C3EFCCFAULL},
+        {0x986DDB5C6B3A76B7ULL, 0xF89629465A75E01CULL},
+        {0xBE89523386091465ULL, 0xF6BBB397F1135823ULL},
+        {0xEE2BA6C0678B597FULL, 0x746AA07DED582E2CULL},
+        {0x94DB483840B717EFULL, 0xA8C2A44EB4571CDCULL},
+        {0xBA121A4650E4DDEBULL, 0x92F34D62616CE413ULL},
+        {0xE896A0D7E51E1566ULL, 0x77B020BAF9C81D17ULL},
+        {0x915E2486EF32CD60ULL, 0x0ACE1474DC1D122EULL},
+        {0xB5B5ADA8AAFF80B8ULL, 0x0D819992132456BAULL},
+        {0xE3231912D5BF60E6ULL, 0x10E1FFF697ED6C69ULL},
+        {0x8DF5EFABC5979C8FULL, 0xCA8D3FFA1EF463C1ULL},
+        {0xB1736B96B6FD83B3ULL, 0xBD308FF8A6B17CB2ULL},
+        {0xDDD0467C64BCE4A0ULL, 0xAC7CB3F6D05DDBDEULL},
+        {0x8AA22C0DBEF60EE4ULL, 0x6BCDF07A423AA96BULL},
+        {0xAD4AB7112EB3929DULL, 0x86C16C98D2C953C6ULL},
+        {0xD89D64D57A607744ULL, 0xE871C7BF077BA8B7ULL},
+        {0x87625F056C7C4A8BULL, 0x11471CD764AD4972ULL},
+        {0xA93AF6C6C79B5D2DULL, 0xD598E40D3DD89BCFULL},
+        {0xD389B47879823479ULL, 0x4AFF1D108D4EC2C3ULL},
+        {0x843610CB4BF160CBULL, 0xCEDF722A585139BAULL},
+        {0xA54394FE1EEDB8FEULL, 0xC2974EB4EE658828ULL},
+        {0xCE947A3DA6A9273EULL, 0x733D226229FEEA32ULL},
+        {0x811CCC668829B887ULL, 0x0806357D5A3F525FULL},
+        {0xA163FF802A3426A8ULL, 0xCA07C2DCB0CF26F7ULL},
+        {0xC9BCFF6034C13052ULL, 0xFC89B393DD02F0B5ULL},
+        {0xFC2C3F3841F17C67ULL, 0xBBAC2078D443ACE2ULL},
+        {0x9D9BA7832936EDC0ULL, 0xD54B944B84AA4C0DULL},
+        {0xC5029163F384A931ULL, 0x0A9E795E65D4DF11ULL},
+        {0xF64335BCF065D37DULL, 0x4D4617B5FF4A16D5ULL},
+        {0x99EA0196163FA42EULL, 0x504BCED1BF8E4E45ULL},
+        {0xC06481FB9BCF8D39ULL, 0xE45EC2862F71E1D6ULL},
+        {0xF07DA27A82C37088ULL, 0x5D767327BB4E5A4CULL},
+        {0x964E858C91BA2655ULL, 0x3A6A07F8D510F86FULL},
+        {0xBBE226EFB628AFEAULL, 0x890489F70A55368BULL},
+        {0xEADAB0ABA3B2DBE5ULL, 0x2B45AC74CCEA842EULL},
+        {0x92C8AE6B464FC96FULL, 0x3B0B8BC90012929DULL},
+        {0xB77ADA0617E3BBCBULL, 0x09CE6EBB40173744ULL},
+        {0xE55990879DDCAABDULL, 0xCC420A6A101D0515ULL},
+        {0x8F57FA54C2A9EAB6ULL, 0x9FA946824A12232DULL},
+        {0xB32DF8E9F3546564ULL, 0x47939822DC96ABF9ULL},
+        {0xDFF9772470297EBDULL, 0x59787E2B93BC56F7ULL},
+        {0x8BFBEA76C619EF36ULL, 0x57EB4EDB3C55B65AULL},
+        {0xAEFAE51477A06B03ULL, 0xEDE622920B6B23F1ULL},
+        {0xDAB99E59958885C4ULL, 0xE95FAB368E45ECEDULL},
+        {0x88B402F7FD75539BULL, 0x11DBCB0218EBB414ULL},
+        {0xAAE103B5FCD2A881ULL, 0xD652BDC29F26A119ULL},
+        {0xD59944A37C0752A2ULL, 0x4BE76D3346F0495FULL},
+        {0x857FCAE62D8493A5ULL, 0x6F70A4400C562DDBULL},
+        {0xA6DFBD9FB8E5B88EULL, 0xCB4CCD500F6BB952ULL},
+        {0xD097AD07A71F26B2ULL, 0x7E2000A41346A7A7ULL},
+        {0x825ECC24C873782FULL, 0x8ED400668C0C28C8ULL},
+        {0xA2F67F2DFA90563BULL, 0x728900802F0F32FAULL},
+        {0xCBB41EF979346BCAULL, 0x4F2B40A03AD2FFB9ULL},
+        {0xFEA126B7D78186BCULL, 0xE2F610C84987BFA8ULL},
+        {0x9F24B832E6B0F436ULL, 0x0DD9CA7D2DF4D7C9ULL},
+        {0xC6EDE63FA05D3143ULL, 0x91503D1C79720DBBULL},
+        {0xF8A95FCF88747D94ULL, 0x75A44C6397CE912AULL},
+        {0x9B69DBE1B548CE7CULL, 0xC986AFBE3EE11ABAULL},
+        {0xC24452DA229B021BULL, 0xFBE85BADCE996168ULL},
+        {0xF2D56790AB41C2A2ULL, 0xFAE27299423FB9C3ULL},
+        {0x97C560BA6B0919A5ULL, 0xDCCD879FC967D41AULL},
+        {0xBDB6B8E905CB600FULL, 0x5400E987BBC1C920ULL},
+        {0xED246723473E3813ULL, 0x290123E9AAB23B68ULL},
+        {0x9436C0760C86E30BULL, 0xF9A0B6720AAF6521ULL},
+        {0xB94470938FA89BCEULL, 0xF808E40E8D5B3E69ULL},
+        {0xE7958CB87392C2C2ULL, 0xB60B1D1230B20E04ULL},
+        {0x90BD77F3483BB9B9ULL, 0xB1C6F22B5E6F48C2ULL},
+        {0xB4ECD5F01A4AA828ULL, 0x1E38AEB6360B1AF3ULL},
+        {0xE2280B6C20DD5232ULL, 0x25C6DA63C38DE1B0ULL},
+        {0x8D590723948A535FULL, 0x579C487E5A38AD0EULL},
+        {0xB0AF48EC79ACE837ULL, 0x2D835A9DF0C6D851ULL},
+        {0xDCDB1B2798182244ULL, 0xF8E431456CF88E65ULL},
+        {0x8A08F0F8BF0F156BULL, 0x1B8E9ECB641B58FFULL},
+        {0xAC8B2D36EED2DAC5ULL, 0xE272467E3D222F3FULL},
+        {0xD7ADF884AA879177ULL, 0x5B0ED81DCC6ABB0FULL},
+        {0x86CCBB52EA94BAEAULL, 0x98E947129FC2B4E9ULL},
+        {0xA87FEA27A539E9A5ULL, 0x3F2398D747B36224ULL},
+        {0xD29FE4B18E88640EULL, 0x8EEC7F0D19A03AADULL},
+        {0x83A3EEEEF9153E89ULL, 0x1953CF68300424ACULL},
+        {0xA48CEAAAB75A8E2BULL, 0x5FA8C3423C052DD7ULL},
+        {0xCDB02555653131B6ULL, 0x3792F412CB06794DULL},
+        {0x808E17555F3EBF11ULL, 0xE2BBD88BBEE40BD0ULL},
+        {0xA0B19D2AB70E6ED6ULL, 0x5B6ACEAEAE9D0EC4ULL},
+        {0xC8DE047564D20A8BULL, 0xF245825A5A445275ULL},
+        {0xFB158592BE068D2EULL, 0xEED6E2F0F0D56712ULL},
+        {0x9CED737BB6C4183DULL, 0x55464DD69685606BULL},
+        {0xC428D05AA4751E4CULL, 0xAA97E14C3C26B886ULL},
+        {0xF53304714D9265DFULL, 0xD53DD99F4B3066A8ULL},
+        {0x993FE2C6D07B7FABULL, 0xE546A8038EFE4029ULL},
+        {0xBF8FDB78849A5F96ULL, 0xDE98520472BDD033ULL},
+        {0xEF73D256A5C0F77CULL, 0x963E66858F6D4440ULL},
+        {0x95A8637627989AADULL, 0xDDE7001379A44AA8ULL},
+        {0xBB127C53B17EC159ULL, 0x5560C018580D5D52ULL},
+        {0xE9D71B689DDE71AFULL, 0xAAB8F01E6E10B4A6ULL},
+        {0x9226712162AB070DULL, 0xCAB3961304CA70E8ULL},
+        {0xB6B00D69BB55C8D1ULL, 0x3D607B97C5FD0D22ULL},
+        {0xE45C10C42A2B3B05ULL, 0x8CB89A7DB77C506AULL},
+        {0x8EB98A7A9A5B04E3ULL, 0x77F3608E92ADB242ULL},
+        {0xB267ED1940F1C61CULL, 0x55F038B237591ED3ULL},
+        {0xDF01E85F912E37A3ULL, 0x6B6C46DEC52F6688ULL},
+        {0x8B61313BBABCE2C6ULL, 0x2323AC4B3B3DA015ULL},
+        {0xAE397D8AA96C1B77ULL, 0xABEC975E0A0D081AULL},
+        {0xD9C7DCED53C72255ULL, 0x96E7BD358C904A21ULL},
+        {0x881CEA14545C7575ULL, 0x7E50D64177DA2E54ULL},
+        {0xAA242499697392D2ULL, 0xDDE50BD1D5D0B9E9ULL},
+        {0xD4AD2DBFC3D07787ULL, 0x955E4EC64B44E864ULL},
+        {0x84EC3C97DA624AB4ULL, 0xBD5AF13BEF0B113EULL},
+        {0xA6274BBDD0FADD61ULL, 0xECB1AD8AEACDD58EULL},
+        {0xCFB11EAD453994BAULL, 0x67DE18EDA5814AF2ULL},
+        {0x81CEB32C4B43FCF4ULL, 0x80EACF948770CED7ULL},
+        {0xA2425FF75E14FC31ULL, 0xA1258379A94D028DULL},
+        {0xCAD2F7F5359A3B3EULL, 0x096EE45813A04330ULL},
+        {0xFD87B5F28300CA0DULL, 0x8BCA9D6E188853FCULL},
+        {0x9E74D1B791E07E48ULL, 0x775EA264CF55347EULL},
+        {0xC612062576589DDAULL, 0x95364AFE032A819EULL},
+        {0xF79687AED3EEC551ULL, 0x3A83DDBD83F52205ULL},
+        {0x9ABE14CD44753B52ULL, 0xC4926A9672793543ULL},
+        {0xC16D9A0095928A27ULL, 0x75B7053C0F178294ULL},
+        {0xF1C90080BAF72CB1ULL, 0x5324C68B12DD6339ULL},
+        {0x971DA05074DA7BEEULL, 0xD3F6FC16EBCA5E04ULL},
+        {0xBCE5086492111AEAULL, 0x88F4BB1CA6BCF585ULL},
+        {0xEC1E4A7DB69561A5ULL, 0x2B31E9E3D06C32E6ULL},
+        {0x9392EE8E921D5D07ULL, 0x3AFF322E62439FD0ULL},
+        {0xB877AA3236A4B449ULL, 0x09BEFEB9FAD487C3ULL},
+        {0xE69594BEC44DE15BULL, 0x4C2EBE687989A9B4ULL},
+        {0x901D7CF73AB0ACD9ULL, 0x0F9D37014BF60A11ULL},
+        {0xB424DC35095CD80FULL, 0x538484C19EF38C95ULL},
+        {0xE12E13424BB40E13ULL, 0x2865A5F206B06FBAULL},
+        {0x8CBCCC096F5088CBULL, 0xF93F87B7442E45D4ULL},
+        {0xAFEBFF0BCB24AAFEULL, 0xF78F69A51539D749ULL},
+        {0xDBE6FECEBDEDD5BEULL, 0xB573440E5A884D1CULL},
+        {0x89705F4136B4A597ULL, 0x31680A88F8953031ULL},
+        {0xABCC77118461CEFCULL, 0xFDC20D2B36BA7C3EULL},
+        {0xD6BF94D5E57A42BCULL, 0x3D32907604691B4DULL},
+        {0x8637BD05AF6C69B5ULL, 0xA63F9A49C2C1B110ULL},
+        {0xA7C5AC471B478423ULL, 0x0FCF80DC33721D54ULL},
+        {0xD1B71758E219652BULL, 0xD3C36113404EA4A9ULL},
+        {0x83126E978D4FDF3BULL, 0x645A1CAC083126EAULL},
+        {0xA3D70A3D70A3D70AULL, 0x3D70A3D70A3D70A4ULL},
+        {0xCCCCCCCCCCCCCCCCULL, 0xCCCCCCCCCCCCCCCDULL},
+        {0x8000000000000000ULL, 0x0000000000000000ULL},
+        {0xA000000000000000ULL, 0x0000000000000000ULL},
+        {0xC800000000000000ULL, 0x0000000000000000ULL},
+        {0xFA00000000000000ULL, 0x0000000000000000ULL},
+        {0x9C40000000000000ULL, 0x0000000000000000ULL},
+        {0xC350000000000000ULL, 0x0000000000000000ULL},
+        {0xF424000000000000ULL, 0x0000000000000000ULL},
+        {0x9896800000000000ULL, 0x0000000000000000ULL},
+        {0xBEBC200000000000ULL, 0x0000000000000000ULL},
+        {0xEE6B280000000000ULL, 0x0000000000000000ULL},
+        {0x9502F90000000000ULL, 0x0000000000000000ULL},
+        {0xBA43B74000000000ULL, 0x0000000000000000ULL},
+        {0xE8D4A51000000000ULL, 0x0000000000000000ULL},
+        {0x9184E72A00000000ULL, 0x0000000000000000ULL},
+        {0xB5E620F480000000ULL, 0x0000000000000000ULL},
+        {0xE35FA931A0000000ULL, 0x0000000000000000ULL},
+        {0x8E1BC9BF04000000ULL, 0x0000000000000000ULL},
+        {0xB1A2BC2EC5000000ULL, 0x0000000000000000ULL},
+        {0xDE0B6B3A76400000ULL, 0x0000000000000000ULL},
+        {0x8AC7230489E80000ULL, 0x0000000000000000ULL},
+        {0xAD78EBC5AC620000ULL, 0x0000000000000000ULL},
+        {0xD8D726B7177A8000ULL, 0x0000000000000000ULL},
+        {0x878678326EAC9000ULL, 0x0000000000000000ULL},
+        {0xA968163F0A57B400ULL, 0x0000000000000000ULL},
+        {0xD3C21BCECCEDA100ULL, 0x0000000000000000ULL},
+        {0x84595161401484A0ULL, 0x0000000000000000ULL},
+        {0xA56FA5B99019A5C8ULL, 0x0000000000000000ULL},
+        {0xCECB8F27F4200F3AULL, 0x0000000000000000ULL},
+        {0x813F3978F8940984ULL, 0x4000000000000000ULL},
+        {0xA18F07D736B90BE5ULL, 0x5000000000000000ULL},
+        {0xC9F2C9CD04674EDEULL, 0xA400000000000000ULL},
+        {0xFC6F7C4045812296ULL, 0x4D00000000000000ULL},
+        {0x9DC5ADA82B70B59DULL, 0xF020000000000000ULL},
+        {0xC5371912364CE305ULL, 0x6C28000000000000ULL},
+        {0xF684DF56C3E01BC6ULL, 0xC732000000000000ULL},
+        {0x9A130B963A6C115CULL, 0x3C7F400000000000ULL},
+        {0xC097CE7BC90715B3ULL, 0x4B9F100000000000ULL},
+        {0xF0BDC21ABB48DB20ULL, 0x1E86D40000000000ULL},
+        {0x96769950B50D88F4ULL, 0x1314448000000000ULL},
+        {0xBC143FA4E250EB31ULL, 0x17D955A000000000ULL},
+        {0xEB194F8E1AE525FDULL, 0x5DCFAB0800000000ULL},
+        {0x92EFD1B8D0CF37BEULL, 0x5AA1CAE500000000ULL},
+        {0xB7ABC627050305ADULL, 0xF14A3D9E40000000ULL},
+        {0xE596B7B0C643C719ULL, 0x6D9CCD05D0000000ULL},
+        {0x8F7E32CE7BEA5C6FULL, 0xE4820023A2000000ULL},
+        {0xB35DBF821AE4F38BULL, 0xDDA2802C8A800000ULL},
+        {0xE0352F62A19E306EULL, 0xD50B2037AD200000ULL},
+        {0x8C213D9DA502DE45ULL, 0x4526F422CC340000ULL},
+        {0xAF298D050E4395D6ULL, 0x9670B12B7F410000ULL},
+        {0xDAF3F04651D47B4CULL, 0x3C0CDD765F114000ULL},
+        {0x88D8762BF324CD0FULL, 0xA5880A69FB6AC800ULL},
+        {0xAB0E93B6EFEE0053ULL, 0x8EEA0D047A457A00ULL},
+        {0xD5D238A4ABE98068ULL, 0x72A4904598D6D880ULL},
+        {0x85A36366EB71F041ULL, 0x47A6DA2B7F864750ULL},
+        {0xA70C3C40A64E6C51ULL, 0x999090B65F67D924ULL},
+        {0xD0CF4B50CFE20765ULL, 0xFFF4B4E3F741CF6DULL},
+        {0x82818F1281ED449FULL, 0xBFF8F10E7A8921A4ULL},
+        {0xA321F2D7226895C7ULL, 0xAFF72D52192B6A0DULL},
+        {0xCBEA6F8CEB02BB39ULL, 0x9BF4F8A69F764490ULL},
+        {0xFEE50B7025C36A08ULL, 0x02F236D04753D5B4ULL},
+        {0x9F4F2726179A2245ULL, 0x01D762422C946590ULL},
+        {0xC722F0EF9D80AAD6ULL, 0x424D3AD2B7B97EF5ULL},
+        {0xF8EBAD2B84E0D58BULL, 0xD2E0898765A7DEB2ULL},
+        {0x9B934C3B330C8577ULL, 0x63CC55F49F88EB2FULL},
+        {0xC2781F49FFCFA6D5ULL, 0x3CBF6B71C76B25FBULL},
+        {0xF316271C7FC3908AULL, 0x8BEF464E3945EF7AULL},
+        {0x97EDD871CFDA3A56ULL, 0x97758BF0E3CBB5ACULL},
+        {0xBDE94E8E43D0C8ECULL, 0x3D52EEED1CBEA317ULL},
+        {0xED63A231D4C4FB27ULL, 0x4CA7AAA863EE4BDDULL},
+        {0x945E455F24FB1CF8ULL, 0x8FE8CAA93E74EF6AULL},
+        {0xB975D6B6EE39E436ULL, 0xB3E2FD538E122B44ULL},
+        {0xE7D34C64A9C85D44ULL, 0x60DBBCA87196B616ULL},
+        {0x90E40FBEEA1D3A4AULL, 0xBC8955E946FE31CDULL},
+        {0xB51D13AEA4A488DDULL, 0x6BABAB6398BDBE41ULL},
+        {0xE264589A4DCDAB14ULL, 0xC696963C7EED2DD1ULL},
+        {0x8D7EB76070A08AECULL, 0xFC1E1DE5CF543CA2ULL},
+        {0xB0DE65388CC8ADA8ULL, 0x3B25A55F43294BCBULL},
+        {0xDD15FE86AFFAD912ULL, 0x49EF0EB713F39EBEULL},
+        {0x8A2DBF142DFCC7ABULL, 0x6E3569326C784337ULL},
+        {0xACB92ED9397BF996ULL, 0x49C2C37F07965404ULL},
+        {0xD7E77A8F87DAF7FBULL, 0xDC33745EC97BE906ULL},
+        {0x86F0AC99B4E8DAFDULL, 0x69A028BB3DED71A3ULL},
+        {0xA8ACD7C0222311BCULL, 0xC40832EA0D68CE0CULL},
+        {0xD2D80DB02AABD62BULL, 0xF50A3FA490C30190ULL},
+        {0x83C7088E1AAB65DBULL, 0x792667C6DA79E0FAULL},
+        {0xA4B8CAB1A1563F52ULL, 0x577001B891185938ULL},
+        {0xCDE6FD5E09ABCF26ULL, 0xED4C0226B55E6F86ULL},
+        {0x80B05E5AC60B6178ULL, 0x544F8158315B05B4ULL},
+        {0xA0DC75F1778E39D6ULL, 0x696361AE3DB1C721ULL},
+        {0xC913936DD571C84CULL, 0x03BC3A19CD1E38E9ULL},
+        {0xFB5878494ACE3A5FULL, 0x04AB48A04065C723ULL},
+        {0x9D174B2DCEC0E47BULL, 0x62EB0D64283F9C76ULL},
+        {0xC45D1DF942711D9AULL, 0x3BA5D0BD324F8394ULL},
+        {0xF5746577930D6500ULL, 0xCA8F44EC7EE36479ULL},
+        {0x9968BF6ABBE85F20ULL, 0x7E998B13CF4E1ECBULL},
+        {0xBFC2EF456AE276E8ULL, 0x9E3FEDD8C321A67EULL},
+        {0xEFB3AB16C59B14A2ULL, 0xC5CFE94EF3EA101EULL},
+        {0x95D04AEE3B80ECE5ULL, 0xBBA1F1D158724A12ULL},
+        {0xBB445DA9CA61281FULL, 0x2A8A6E45AE8EDC97ULL},
+        {0xEA1575143CF97226ULL, 0xF52D09D71A3293BDULL},
+        {0x924D692CA61BE758ULL, 0x593C2626705F9C56ULL},
+        {0xB6E0C377CFA2E12EULL, 0x6F8B2FB00C77836CULL},
+        {0xE498F455C38B997AULL, 0x0B6DFB9C0F956447ULL},
+        {0x8EDF98B59A373FECULL, 0x4724BD4189BD5EACULL},
+        {0xB2977EE300C50FE7ULL, 0x58EDEC91EC2CB657ULL},
+        {0xDF3D5E9BC0F653E1ULL, 0x2F2967B66737E3EDULL},
+        {0x8B865B215899F46CULL, 0xBD79E0D20082EE74ULL},
+        {0xAE67F1E9AEC07187ULL, 0xECD8590680A3AA11ULL},
+        {0xDA01EE641A708DE9ULL, 0xE80E6F4820CC9495ULL},
+        {0x884134FE908658B2ULL, 0x3109058D147FDCDDULL},
+        {0xAA51823E34A7EEDEULL, 0xBD4B46F0599FD415ULL},
+        {0xD4E5E2CDC1D1EA96ULL, 0x6C9E18AC7007C91AULL},
+        {0x850FADC09923329EULL, 0x03E2CF6BC604DDB0ULL},
+        {0xA6539930BF6BFF45ULL, 0x84DB8346B786151CULL},
+        {0xCFE87F7CEF46FF16ULL, 0xE612641865679A63ULL},
+        {0x81F14FAE158C5F6EULL, 0x4FCB7E8F3F60C07EULL},
+        {0xA26DA3999AEF7749ULL, 0xE3BE5E330F38F09DULL},
+        {0xCB090C8001AB551CULL, 0x5CADF5BFD3072CC5ULL},
+        {0xFDCB4FA002162A63ULL, 0x73D9732FC7C8F7F6ULL},
+        {0x9E9F11C4014DDA7EULL, 0x2867E7FDDCDD9AFAULL},
+        {0xC646D63501A1511DULL, 0xB281E1FD541501B8ULL},
+        {0xF7D88BC24209A565ULL, 0x1F225A7CA91A4226ULL},
+        {0x9AE757596946075FULL, 0x3375788DE9B06958ULL},
+        {0xC1A12D2FC3978937ULL, 0x0052D6B1641C83AEULL},
+        {0xF209787BB47D6B84ULL, 0xC0678C5DBD23A49AULL},
+        {0x9745EB4D50CE6332ULL, 0xF840B7BA963646E0ULL},
+        {0xBD176620A501FBFFULL, 0xB650E5A93BC3D898ULL},
+        {0xEC5D3FA8CE427AFFULL, 0xA3E51F138AB4CEBEULL},
+        {0x93BA47C980E98CDFULL, 0xC66F336C36B10137ULL},
+        {0xB8A8D9BBE123F017ULL, 0xB80B0047445D4184ULL},
+        {0xE6D3102AD96CEC1DULL, 0xA60DC059157491E5ULL},
+        {0x9043EA1AC7E41392ULL, 0x87C89837AD68DB2FULL},
+        {0xB454E4A179DD1877ULL, 0x29BABE4598C311FBULL},
+        {0xE16A1DC9D8545E94ULL, 0xF4296DD6FEF3D67AULL},
+        {0x8CE2529E2734BB1DULL, 0x1899E4A65F58660CULL},
+        {0xB01AE745B101E9E4ULL, 0x5EC05DCFF72E7F8FULL},
+        {0xDC21A1171D42645DULL, 0x76707543F4FA1F73ULL},
+        {0x899504AE72497EBAULL, 0x6A06494A791C53A8ULL},
+        {0xABFA45DA0EDBDE69ULL, 0x0487DB9D17636892ULL},
+        {0xD6F8D7509292D603ULL, 0x45A9D2845D3C42B6ULL},
+        {0x865B86925B9BC5C2ULL, 0x0B8A2392BA45A9B2ULL},
+        {0xA7F26836F282B732ULL, 0x8E6CAC7768D7141EULL},
+        {0xD1EF0244AF2364FFULL, 0x3207D795430CD926ULL},
+        {0x8335616AED761F1FULL, 0x7F44E6BD49E807B8ULL},
+        {0xA402B9C5A8D3A6E7ULL, 0x5F16206C9C6209A6ULL},
+        {0xCD036837130890A1ULL, 0x36DBA887C37A8C0FULL},
+        {0x802221226BE55A64ULL, 0xC2494954DA2C9789ULL},
+        {0xA02AA96B06DEB0FDULL, 0xF2DB9BAA10B7BD6CULL},
+        {0xC83553C5C8965D3DULL, 0x6F92829494E5ACC7ULL},
+        {0xFA42A8B73ABBF48CULL, 0xCB772339BA1F17F9ULL},
+        {0x9C69A97284B578D7ULL, 0xFF2A760414536EFBULL},
+        {0xC38413CF25E2D70DULL, 0xFEF5138519684ABAULL},
+        {0xF46518C2EF5B8CD1ULL, 0x7EB258665FC25D69ULL},
+        {0x98BF2F79D5993802ULL, 0xEF2F773FFBD97A61ULL},
+        {0xBEEEFB584AFF8603ULL, 0xAAFB550FFACFD8FAULL},
+        {0xEEAABA2E5DBF6784ULL, 0x95BA2A53F983CF38ULL},
+        {0x952AB45CFA97A0B2ULL, 0xDD945A747BF26183ULL},
+        {0xBA756174393D88DFULL, 0x94F971119AEEF9E4ULL},
+        {0xE912B9D1478CEB17ULL, 0x7A37CD5601AAB85DULL},
+        {0x91ABB422CCB812EEULL, 0xAC62E055C10AB33AULL},
+        {0xB616A12B7FE617AAULL, 0x577B986B314D6009ULL},
+        {0xE39C49765FDF9D94ULL, 0xED5A7E85FDA0B80BULL},
+        {0x8E41ADE9FBEBC27DULL, 0x14588F13BE847307ULL},
+        {0xB1D219647AE6B31CULL, 0x596EB2D8AE258FC8ULL},
+        {0xDE469FBD99A05FE3ULL, 0x6FCA5F8ED9AEF3BBULL},
+        {0x8AEC23D680043BEEULL, 0x25DE7BB9480D5854ULL},
+        {0xADA72CCC20054AE9ULL, 0xAF561AA79A10AE6AULL},
+        {0xD910F7FF28069DA4ULL, 0x1B2BA1518094DA04ULL},
+        {0x87AA9AFF79042286ULL, 0x90FB44D2F05D0842ULL},
+        {0xA99541BF57452B28ULL, 0x353A1607AC744A53ULL},
+        {0xD3FA922F2D1675F2ULL, 0x42889B8997915CE8ULL},
+        {0x847C9B5D7C2E09B7ULL, 0x69956135FEBADA11ULL},
+        {0xA59BC234DB398C25ULL, 0x43FAB9837E699095ULL},
+        {0xCF02B2C21207EF2EULL, 0x94F967E45E03F4BBULL},
+        {0x8161AFB94B44F57DULL, 0x1D1BE0EEBAC278F5ULL},
+        {0xA1BA1BA79E1632DCULL, 0x6462D92A69731732ULL},
+        {0xCA28A291859BBF93ULL, 0x7D7B8F7503CFDCFEULL},
+        {0xFCB2CB35E702AF78ULL, 0x5CDA735244C3D43EULL},
+        {0x9DEFBF01B061ADABULL, 0x3A0888136AFA64A7ULL},
+        {0xC56BAEC21C7A1916ULL, 0x088AAA1845B8FDD0ULL},
+        {0xF6C69A72A3989F5BULL, 0x8AAD549E57273D45ULL},
+        {0x9A3C2087A63F6399ULL, 0x36AC54E2F678864BULL},
+        {0xC0CB28A98FCF3C7FULL, 0x84576A1BB416A7DDULL},
+        {0xF0FDF2D3F3C30B9FULL, 0x656D44A2A11C51D5ULL},
+        {0x969EB7C47859E743ULL, 0x9F644AE5A4B1B325ULL},
+        {0xBC4665B596706114ULL, 0x873D5D9F0DDE1FEEULL},
+        {0xEB57FF22FC0C7959ULL, 0xA90CB506D155A7EAULL},
+        {0x9316FF75DD87CBD8ULL, 0x09A7F12442D588F2ULL},
+        {0xB7DCBF5354E9BECEULL, 0x0C11ED6D538AEB2FULL},
+        {0xE5D3EF282A242E81ULL, 0x8F1668C8A86DA5FAULL},
+        {0x8FA475791A569D10ULL, 0xF96E017D694487BCULL},
+        {0xB38D92D760EC4455ULL, 0x37C981DCC395A9ACULL},
+        {0xE070F78D3927556AULL, 0x85BBE253F47B1417ULL},
+        {0x8C469AB843B89562ULL, 0x93956D7478CCEC8EULL},
+        {0xAF58416654A6BABBULL, 0x387AC8D1970027B2ULL},
+        {0xDB2E51BFE9D0696AULL, 0x06997B05FCC0319EULL},
+        {0x88FCF317F22241E2ULL, 0x441FECE3BDF81F03ULL},
+        {0xAB3C2FDDEEAAD25AULL, 0xD527E81CAD7626C3ULL},
+        {0xD60B3BD56A5586F1ULL, 0x8A71E223D8D3B074ULL},
+        {0x85C7056562757456ULL, 0xF6872D5667844E49ULL},
+        {0xA738C6BEBB12D16CULL, 0xB428F8AC016561DBULL},
+        {0xD106F86E69D785C7ULL, 0xE13336D701BEBA52ULL},
+        {0x82A45B450226B39CULL, 0xECC0024661173473ULL},
+        {0xA34D721642B06084ULL, 0x27F002D7F95D0190ULL},
+        {0xCC20CE9BD35C78A5ULL, 0x31EC038DF7B441F4ULL},
+        {0xFF290242C83396CEULL, 0x7E67047175A15271ULL},
+        {0x9F79A169BD203E41ULL, 0x0F0062C6E984D386ULL},
+        {0xC75809C42C684DD1ULL, 0x52C07B78A3E60868ULL},
+        {0xF92E0C3537826145ULL, 0xA7709A56CCDF8A82ULL},
+        {0x9BBCC7A142B17CCBULL, 0x88A66076400BB691ULL},
+        {0xC2ABF989935DDBFEULL, 0x6ACFF893D00EA435ULL},
+        {0xF356F7EBF83552FEULL, 0x0583F6B8C4124D43ULL},
+        {0x98165AF37B2153DEULL, 0xC3727A337A8B704AULL},
+        {0xBE1BF1B059E9A8D6ULL, 0x744F18C0592E4C5CULL},
+        {0xEDA2EE1C7064130CULL, 0x1162DEF06F79DF73ULL},
+        {0x9485D4D1C63E8BE7ULL, 0x8ADDCB5645AC2BA8ULL},
+        {0xB9A74A0637CE2EE1ULL, 0x6D953E2BD7173692ULL},
+        {0xE8111C87C5C1BA99ULL, 0xC8FA8DB6CCDD0437ULL},
+        {0x910AB1D4DB9914A0ULL, 0x1D9C9892400A22A2ULL},
+        {0xB54D5E4A127F59C8ULL, 0x2503BEB6D00CAB4BULL},
+        {0xE2A0B5DC971F303AULL, 0x2E44AE64840FD61DULL},
+        {0x8DA471A9DE737E24ULL, 0x5CEAECFED289E5D2ULL},
+        {0xB10D8E1456105DADULL, 0x7425A83E872C5F47ULL},
+        {0xDD50F1996B947518ULL, 0xD12F124E28F77719ULL},
+        {0x8A5296FFE33CC92FULL, 0x82BD6B70D99AAA6FULL},
+        {0xACE73CBFDC0BFB7BULL, 0x636CC64D1001550BULL},
+        {0xD8210BEFD30EFA5AULL, 0x3C47F7E05401AA4EULL},
+        {0x8714A775E3E95C78ULL, 0x65ACFAEC34810A71ULL},
+        {0xA8D9D1535CE3B396ULL, 0x7F1839A741A14D0DULL},
+        {0xD31045A8341CA07CULL, 0x1EDE48111209A050ULL},
+        {0x83EA2B892091E44DULL, 0x934AED0AAB460432ULL},
+        {0xA4E4B66B68B65D60ULL, 0xF81DA84D5617853FULL},
+        {0xCE1DE40642E3F4B9ULL, 0x36251260AB9D668EULL},
+        {0x80D2AE83E9CE78F3ULL, 0xC1D72B7C6B426019ULL},
+        {0xA1075A24E4421730ULL, 0xB24CF65B8612F81FULL},
+        {0xC94930AE1D529CFCULL, 0xDEE033F26797B627ULL},
+        {0xFB9B7CD9A4A7443CULL, 0x169840EF017DA3B1ULL},
+        {0x9D412E0806E88AA5ULL, 0x8E1F289560EE864EULL},
+        {0xC491798A08A2AD4EULL, 0xF1A6F2BAB92A27E2ULL},
+        {0xF5B5D7EC8ACB58A2ULL, 0xAE10AF696774B1DBULL},
+        {0x9991A6F3D6BF1765ULL, 0xACCA6DA1E0A8EF29ULL},
+        {0xBFF610B0CC6EDD3FULL, 0x17FD090A58D32AF3ULL},
+        {0xEFF394DCFF8A948EULL, 0xDDFC4B4CEF07F5B0ULL},
+        {0x95F83D0A1FB69CD9ULL, 0x4ABDAF101564F98EULL},
+        {0xBB764C4CA7A4440FULL, 0x9D6D1AD41ABE37F1ULL},
+        {0xEA53DF5FD18D5513ULL, 0x84C86189216DC5EDULL},
+        {0x92746B9BE2F8552CULL, 0x32FD3CF5B4E49BB4ULL},
+        {0xB7118682DBB66A77ULL, 0x3FBC8C33221DC2A1ULL},
+        {0xE4D5E82392A40515ULL, 0x0FABAF3FEAA5334AULL},
+        {0x8F05B1163BA6832DULL, 0x29CB4D87F2A7400EULL},
+        {0xB2C71D5BCA9023F8ULL, 0x743E20E9EF511012ULL},
+        {0xDF78E4B2BD342CF6ULL, 0x914DA9246B255416ULL},
+        {0x8BAB8EEFB6409C1AULL, 0x1AD089B6C2F7548EULL},
+        {0xAE9672ABA3D0C320ULL, 0xA184AC2473B529B1ULL},
+        {0xDA3C0F568CC4F3E8ULL, 0xC9E5D72D90A2741EULL},
+        {0x8865899617FB1871ULL, 0x7E2FA67C7A658892ULL},
+        {0xAA7EEBFB9DF9DE8DULL, 0xDDBB901B98FEEAB7ULL},
+        {0xD51EA6FA85785631ULL, 0x552A74227F3EA565ULL},
+        {0x8533285C936B35DEULL, 0xD53A88958F87275FULL},
+        {0xA67FF273B8460356ULL, 0x8A892ABAF368F137ULL},
+        {0xD01FEF10A657842CULL, 0x2D2B7569B0432D85ULL},
+        {0x8213F56A67F6B29BULL, 0x9C3B29620E29FC73ULL},
+        {0xA298F2C501F45F42ULL, 0x8349F3BA91B47B8FULL},
+        {0xCB3F2F7642717713ULL, 0x241C70A936219A73ULL},
+        {0xFE0EFB53D30DD4D7ULL, 0xED238CD383AA0110ULL},
+        {0x9EC95D1463E8A506ULL, 0xF4363804324A40AAULL},
+        {0xC67BB4597CE2CE48ULL, 0xB143C6053EDCD0D5ULL},
+        {0xF81AA16FDC1B81DAULL, 0xDD94B7868E94050AULL},
+        {0x9B10A4E5E9913128ULL, 0xCA7CF2B4191C8326ULL},
+        {0xC1D4CE1F63F57D72ULL, 0xFD1C2F611F63A3F0ULL},
+        {0xF24A01A73CF2DCCFULL, 0xBC633B39673C8CECULL},
+        {0x976E41088617CA01ULL, 0xD5BE0503E085D813ULL},
+        {0xBD49D14AA79DBC82ULL, 0x4B2D8644D8A74E18ULL},
+        {0xEC9C459D51852BA2ULL, 0xDDF8E7D60ED1219EULL},
+        {0x93E1AB8252F33B45ULL, 0xCABB90E5C942B503ULL},
+        {0xB8DA1662E7B00A17ULL, 0x3D6A751F3B936243ULL},
+        {0xE7109BFBA19C0C9DULL, 0x0CC512670A783AD4ULL},
+        {0x906A617D450187E2ULL, 0x27FB2B80668B24C5ULL},
+        {0xB484F9DC9641E9DAULL, 0xB1F9F660802DEDF6ULL},
+        {0xE1A63853BBD26451ULL, 0x5E7873F8A0396973ULL},
+        {0x8D07E33455637EB2ULL, 0xDB0B487B6423E1E8ULL},
+        {0xB049DC016ABC5E5FULL, 0x91CE1A9A3D2CDA62ULL},
+        {0xDC5C5301C56B75F7ULL, 0x7641A140CC7810FBULL},
+        {0x89B9B3E11B6329BAULL, 0xA9E904C87FCB0A9DULL},
+        {0xAC2820D9623BF429ULL, 0x546345FA9FBDCD44ULL},
+        {0xD732290FBACAF133ULL, 0xA97C177947AD4095ULL},
+        {0x867F59A9D4BED6C0ULL, 0x49ED8EABCCCC485DULL},
+        {0xA81F301449EE8C70ULL, 0x5C68F256BFFF5A74ULL},
+        {0xD226FC195C6A2F8CULL, 0x73832EEC6FFF3111ULL},
+        {0x83585D8FD9C25DB7ULL, 0xC831FD53C5FF7EABULL},
+        {0xA42E74F3D032F525ULL, 0xBA3E7CA8B77F5E55ULL},
+        {0xCD3A1230C43FB26FULL, 0x28CE1BD2E55F35EBULL},
+        {0x80444B5E7AA7CF85ULL, 0x7980D163CF5B81B3ULL},
+        {0xA0555E361951C366ULL, 0xD7E105BCC332621FULL},
+        {0xC86AB5C39FA63440ULL, 0x8DD9472BF3FEFAA7ULL},
+        {0xFA856334878FC150ULL, 0xB14F98F6F0FEB951ULL},
+        {0x9C935E00D4B9D8D2ULL, 0x6ED1BF9A569F33D3ULL},
+        {0xC3B8358109E84F07ULL, 0x0A862F80EC4700C8ULL},
+        {0xF4A642E14C6262C8ULL, 0xCD27BB612758C0FAULL},
+        {0x98E7E9CCCFBD7DBDULL, 0x8038D51CB897789CULL},
+        {0xBF21E44003ACDD2CULL, 0xE0470A63E6BD56C3ULL},
+        {0xEEEA5D5004981478ULL, 0x1858CCFCE06CAC74ULL},
+        {0x95527A5202DF0CCBULL, 0x0F37801E0C43EBC8ULL},
+        {0xBAA718E68396CFFDULL, 0xD30560258F54E6BAULL},
+        {0xE950DF20247C83FDULL, 0x47C6B82EF32A2069ULL},
+        {0x91D28B7416CDD27EULL, 0x4CDC331D57FA5441ULL},
+        {0xB6472E511C81471DULL, 0xE0133FE4ADF8E952ULL},
+        {0xE3D8F9E563A198E5ULL, 0x58180FDDD97723A6ULL},
+        {0x8E679C2F5E44FF8FULL, 0x570F09EAA7EA7648ULL},
+    };
+
+    static const f64 ExactPow10[] =
+    {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+    };
+
+    inline s32 countLeadingZeros(u64 x)
+    {
+        CPPGLTF_ASSERT(0 != x);
+#if defined(_MSC_VER) && defined(_M_X64)
+        unsigned long index;
+        _BitScanReverse64(&index, x);
+        return 63-static_cast<s32>(index);
+#elif defined(_MSC_VER)
+        unsigned long index;
+        if(_BitScanReverse(&index, static_cast<u32>(x>>32))){
+            return 31-static_cast<s32>(index);
+        }
+        _BitScanReverse(&index, static_cast<u32>(x));
+        return 63-static_cast<s32>(index);
+#else
+        return __builtin_clzll(x);
+#endif
+    }
+
+    /**
+    @return Lower 64 bits of x0*x1
+    */
+    inline u64 multiply128(u64 x0, u64 x1, u64& high)
+    {
+#if defined(__SIZEOF_INT128__)
+        unsigned __int128 r = static_cast<unsigned __int128>(x0)*x1;
+        high = static_cast<u64>(r>>64);
+        return static_cast<u64>(r);
+#elif defined(_MSC_VER) && defined(_M_X64)
+        return _umul128(x0, x1, &high);
+#else
+        u64 a0 = x0&0xFFFFFFFFULL;
+        u64 a1 = x0>>32;
+        u64 b0 = x1&0xFFFFFFFFULL;
+        u64 b1 = x1>>32;
+        u64 p00 = a0*b0;
+        u64 p01 = a0*b1;
+        u64 p10 = a1*b0;
+        u64 p11 = a1*b1;
+        u64 middle = p10 + (p00>>32) + (p01&0xFFFFFFFFULL);
+        high = p11 + (middle>>32) + (p01>>32);
+        return (middle<<32) | (p00&0xFFFFFFFFULL);
+#endif
+    }
+
+    /**
+    @brief Eisel-Lemire algorithm, w * 10^q
+    @return false if the result can not be decided exactly
+    */
+    boolean computeFloat64(f64& result, u64 w, s32 q, boolean negative)
+    {
+        if(0 == w || q<Pow10MinExponent){
+            result = negative? -0.0 : 0.0;
+            return true;
+        }
+        if(Pow10MaxExponent<q){
+            result = negative? -HUGE_VAL : HUGE_VAL;
+            return true;
+        }
+        //Normalization
+        s32 lz = countLeadingZeros(w);
+        w <<= lz;
+        u64 exponent = static_cast<u64>(((217706*q)>>16) + 64 + 1023 - lz);
+
+        //Multiplication
+        const u64* pow10 = Pow10Mantissa128[q-Pow10MinExponent];
+        u64 high;
+        u64 low = multiply128(w, pow10[0], high);
+
+        //Wider approximation
+        if(0x1FFU == (high&0x1FFU) && (low+w)<low){
+            u64 high1;
+            u64 low1 = multiply128(w, pow10[1], high1);
+            u64 mergedHigh = high;
+            u64 mergedLow = low + high1;
+            if(mergedLow<low){
+                ++mergedHigh;
+            }
+            if(0x1FFU == (mergedHigh&0x1FFU) && 0 == (mergedLow+1) && (low1+w)<low1){
+                return false;
+            }
+            high = mergedHigh;
+            low = mergedLow;
+        }
+
+        //Shift to 54 bits
+        u64 msb = high>>63;
+        u64 mantissa = high>>(msb+9);
+        exponent -= 1^msb;
+
+        //Half-way ambiguity
+        if(0 == low && 0 == (high&0x1FFU) && 1 == (mantissa&3U)){
+            return false;
+        }
+
+        //From 54 to 53 bits
+        mantissa += mantissa&1U;
+        mantissa >>= 1;
+        if(0 < (mantissa>>53)){
+            mantissa >>= 1;
+            ++exponent;
+        }
+        //Subnormal, infinity or NaN
+        if(0x7FEU <= (exponent-1)){
+            return false;
+        }
+        u64 bits = (exponent<<52) | (mantissa&0x000FFFFFFFFFFFFFULL);
+        if(negative){
+            bits |= 0x8000000000000000ULL;
+        }
+        ::memcpy(&result, &bits, sizeof(f64));
+        return true;
+    }
+
+    inline boolean isDigit(Char c)
+    {
+        return '0'<=c && c<='9';
+    }
+
+    /**
+    @brief Parse a JSON integer token
+    */
+    s64 parseInt(s32 length, const Char* str)
+    {
+        CPPGLTF_ASSERT(CPPGLTF_NULL != str);
+        const Char* end = str+length;
+        boolean negative = false;
+        if(str<end && '-' == *str){
+            negative = true;
+            ++str;
+        }
+        u64 value = 0;
+        for(; str<end && isDigit(*str); ++str){
+            value = value*10 + static_cast<u64>(*str-'0');
+        }
+        return negative? -static_cast<s64>(value) : static_cast<s64>(value);
+    }
+
+    /**
+    @brief Parse a JSON number token into the nearest double
+    @param str ... the token, which must be followed by a character which can not be a part of a number
+    */
+    f64 parseFloat(s32 length, const Char* str)
+    {
+        static const s32 MaxDigits = 19;
+        CPPGLTF_ASSERT(CPPGLTF_NULL != str);
+        const Char* begin = str;
+        const Char* end = str+length;
+        boolean negative = false;
+        if(str<end && '-' == *str){
+            negative = true;
+            ++str;
+        }
+
+        //Significand, at most 19 digits fit in 64 bits
+        u64 w = 0;
+        s32 digits = 0;
+        s32 q = 0;
+        for(; str<end && isDigit(*str); ++str){
+            if(0<digits || '0' != *str){
+                ++digits;
+            }
+            w = w*10 + static_cast<u64>(*str-'0');
+        }
+        if(str<end && '.' == *str){
+            ++str;
+            for(; str<end && isDigit(*str); ++str){
+                if(0<digits || '0' != *str){
+                    ++digits;
+                }
+                w = w*10 + static_cast<u64>(*str-'0');
+                --q;
+            }
+        }
+        if(MaxDigits<digits){
+            return strtod(begin, CPPGLTF_NULL);
+        }
+        if(str<end && ('e' == *str || 'E' == *str)){
+            ++str;
+            boolean negativeExponent = false;
+            if(str<end && ('-' == *str || '+' == *str)){
+                negativeExponent = ('-' == *str);
+                ++str;
+            }
+            s32 e = 0;
+            for(; str<end && isDigit(*str); ++str){
+                if(e<0x10000){
+                    e = e*10 + (*str-'0');
+                }
+            }
+            q += negativeExponent? -e : e;
+        }
+
+        //Clinger's fast path, both w and 10^|q| are exact
+        if(-22<=q && q<=22 && w<=(0x01ULL<<53)){
+            f64 d = static_cast<f64>(w);
+            d = (q<0)? d/ExactPow10[-q] : d*ExactPow10[q];
+            return negative? -d : d;
+        }
+        f64 result;
+        if(computeFloat64(result, w, q, negative)){
+            return result;
+        }
+        return strtod(begin, CPPGLTF_NULL);
+    }
+}
+
     //---------------------------------------------------------------
     //---
     //--- RangeStream
@@ -3070,6 +5572,22 @@ namespace
     //---------------------------------------------------------------
     RangeStream::RangeStream(IStream* stream, const Range& range)
         :stream_(stream)
+        ,data_(CPPGLTF_NULL)
+        ,start_(range.start_)
+        ,length_(range.length_)
+    {
+        CPPGLTF_ASSERT(CPPGLTF_NULL != stream_);
+        CPPGLTF_ASSERT(0<=start_);
+        CPPGLTF_ASSERT(0<=length_);
+        const u8* data = stream_->data();
+        if(CPPGLTF_NULL != data){
+            data_ = reinterpret_cast<const Char*>(data+start_);
+        }
+    }
+
+    RangeStream::RangeStream(IStream* stream, const u8* data, const Range& range)
+        :stream_(stream)
+        ,data_(CPPGLTF_NULL != data? reinterpret_cast<const Char*>(data+range.start_) : CPPGLTF_NULL)
         ,start_(range.start_)
         ,length_(range.length_)
     {
@@ -3086,6 +5604,10 @@ namespace
     s32 RangeStream::read(u8* dst)
     {
         CPPGLTF_ASSERT(CPPGLTF_NULL != dst);
+        if(CPPGLTF_NULL != data_){
+            ::memcpy(dst, data_, length_);
+            return 1;
+        }
         off_t pos = stream_->tell();
         if(!stream_->seek(start_)){
             return 0;
@@ -3100,6 +5622,11 @@ namespace
     s32 RangeStream::readAsString(Char* str)
     {
         CPPGLTF_ASSERT(CPPGLTF_NULL != str);
+        if(CPPGLTF_NULL != data_){
+            ::memcpy(str, data_, length_);
+            str[length_] = '\0';
+            return 1;
+        }
         off_t pos = stream_->tell();
         if(!stream_->seek(start_)){
             return 0;
@@ -3115,125 +5642,390 @@ namespace
     s32 RangeStream::readAsString(String& str)
     {
         str.resize(length_);
-        off_t pos = stream_->tell();
-        if(!stream_->seek(start_)){
-            return 0;
-        }
-        Char* c = str.c_str();
-        s32 ret = stream_->read(reinterpret_cast<u8*>(c), length_);
-        if(!stream_->seek(pos)){
-            return 0;
-        }
-        c[length_] = '\0';
-        return ret;
+        return readAsString(str.c_str());
     }
 
-    s32 RangeStream::readAsInt(s32 defaultValue)
+    const Char* RangeStream::readAsNumber(Char*& allocated, Char* buffer, s32 size)
     {
-        static const s32 MaxSize = 32;
-        CPPGLTF_ASSERT(length_<MaxSize);
-        off_t pos = stream_->tell();
-        if(!stream_->seek(start_)){
-            return defaultValue;
-        }
-        Char buffer[MaxSize];
-        off_t ret = stream_->read(reinterpret_cast<u8*>(buffer), length_);
-        if(!stream_->seek(pos)){
-            return defaultValue;
+        CPPGLTF_ASSERT(CPPGLTF_NULL != buffer);
+        allocated = CPPGLTF_NULL;
+        if(CPPGLTF_NULL != data_){
+            //A number token is always followed by a non-numeric character
+            return data_;
         }
-        if(ret<=0){
-            return defaultValue;
+        if(size<=length_){
+            allocated = (Char*)CPPGLTF_MALLOC(length_+1);
+            if(CPPGLTF_NULL == allocated){
+                return CPPGLTF_NULL;
+            }
+            buffer = allocated;
         }
-        buffer[length_] = '\0';
-        return atol(buffer);
-    }
-
-    f32 RangeStream::readAsFloat(f32 defaultValue)
-    {
-        static const s32 MaxSize = 32;
-        CPPGLTF_ASSERT(length_<MaxSize);
         off_t pos = stream_->tell();
         if(!stream_->seek(start_)){
-            return defaultValue;
+            return CPPGLTF_NULL;
         }
-        Char buffer[MaxSize];
         off_t ret = stream_->read(reinterpret_cast<u8*>(buffer), length_);
         if(!stream_->seek(pos)){
-            return defaultValue;
+            return CPPGLTF_NULL;
         }
         if(ret<=0){
-            return defaultValue;
+            return CPPGLTF_NULL;
         }
         buffer[length_] = '\0';
-        return static_cast<f32>(atof(buffer));
+        return buffer;
     }
 
-    //---------------------------------------------------------------
-    //---
-    //--- JSONReader
-    //---
-    //---------------------------------------------------------------
-    JSONReader::JSONReader(IStream& istream, JSONEventHandler& handler)
-        :flags_(0)
-        ,istream_(istream)
-        ,handler_(handler)
-    {}
-
-    JSONReader::~JSONReader()
+    s32 RangeStream::readAsInt(s32 defaultValue)
     {
+        Char buffer[MaxNumberSize];
+        Char* allocated;
+        const Char* str = readAsNumber(allocated, buffer, MaxNumberSize);
+        s32 value = CPPGLTF_NULL != str? static_cast<s32>(parseInt(length_, str)) : defaultValue;
+        CPPGLTF_FREE(allocated);
+        return value;
     }
 
-    boolean JSONReader::read(s32 flags)
+    s64 RangeStream::readAsInt64(s64 defaultValue)
     {
-        handler_.begin();
-        flags_ = flags;
-        Range value;
-        if(!skipSpace()){
-            if(istream_.isEOF()){
-                return true;
-            } else{
-                onError();
-                return false;
-            }
-        }
-        s32 type = getValue(value);
-        if(JSON_Error == type || (JSON_Array != type && JSON_Object != type)){
-            return false;
-        }
+        Char buffer[MaxNumberSize];
+        Char* allocated;
+        const Char* str = readAsNumber(allocated, buffer, MaxNumberSize);
+        s64 value = CPPGLTF_NULL != str? parseInt(length_, str) : defaultValue;
+        CPPGLTF_FREE(allocated);
+        return value;
+    }
 
-        //while(!istream_.isEOF()){
-        //    s32 c = istream_.get();
-        //    if(c==EOF){
-        //        break;
-        //    }
-        //    if(!isspace(c)){
-        //        return false;
-        //    }
-        //}
+    f32 RangeStream::readAsFloat(f32 defaultValue)
+    {
+        Char buffer[MaxNumberSize];
+        Char* allocated;
+        const Char* str = readAsNumber(allocated, buffer, MaxNumberSize);
+        f32 value = CPPGLTF_NULL != str? static_cast<f32>(parseFloat(length_, str)) : defaultValue;
+        CPPGLTF_FREE(allocated);
+        return value;
+    }
 
-        handler_.root(type, RangeStream(&istream_, value));
-        handler_.end();
-        return true;
+    f64 RangeStream::readAsDouble(f64 defaultValue)
+    {
+        Char buffer[MaxNumberSize];
+        Char* allocated;
+        const Char* str = readAsNumber(allocated, buffer, MaxNumberSize);
+        f64 value = CPPGLTF_NULL != str? parseFloat(length_, str) : defaultValue;
+        CPPGLTF_FREE(allocated);
+        return value;
     }
 
-    boolean JSONReader::skipSpace()
+namespace
+{
+    inline s32 countTrailingZeros(u32 x)
     {
-        for(;;){
-            s32 c = istream_.get();
-            if(c<0){
-                return false;
-            }
-            if(!isspace(c)){
-                return EOF != istream_.unget(c);
-            }
-        }
+        CPPGLTF_ASSERT(0 != x);
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward(&index, x);
+        return static_cast<s32>(index);
+#else
+        return __builtin_ctz(x);
+#endif
     }
 
-    boolean JSONReader::check(const s8* str)
+    inline boolean isJSONSpace(u8 c)
+    {
+        return ' '==c || '\t'==c || '\n'==c || '\r'==c;
+    }
+
+    inline boolean isPlainStringChar(u8 c)
+    {
+        return '"'!=c && '\\'!=c && '\t'!=c && '\n'!=c && c<0x80U;
+    }
+
+    /**
+    @return Position of the first byte which is not a JSON white space in [pos, end)
+    */
+    off_t scanSpace(const u8* data, off_t pos, off_t end)
+    {
+#ifdef CPPGLTF_AVX2
+        {
+            const __m256i space = _mm256_set1_epi8(' ');
+            const __m256i tab = _mm256_set1_epi8('\t');
+            const __m256i lf = _mm256_set1_epi8('\n');
+            const __m256i cr = _mm256_set1_epi8('\r');
+            for(; pos+32<=end; pos+=32){
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data+pos));
+                __m256i m = _mm256_or_si256(
+                    _mm256_or_si256(_mm256_cmpeq_epi8(v, space), _mm256_cmpeq_epi8(v, tab)),
+                    _mm256_or_si256(_mm256_cmpeq_epi8(v, lf), _mm256_cmpeq_epi8(v, cr)));
+                u32 mask = ~static_cast<u32>(_mm256_movemask_epi8(m));
+                if(0 != mask){
+                    return pos + countTrailingZeros(mask);
+                }
+            }
+        }
+#endif
+#ifdef CPPGLTF_SSE2
+        {
+            const __m128i space = _mm_set1_epi8(' ');
+            const __m128i tab = _mm_set1_epi8('\t');
+            const __m128i lf = _mm_set1_epi8('\n');
+            const __m128i cr = _mm_set1_epi8('\r');
+            for(; pos+16<=end; pos+=16){
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data+pos));
+                __m128i m = _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(v, space), _mm_cmpeq_epi8(v, tab)),
+                    _mm_or_si128(_mm_cmpeq_epi8(v, lf), _mm_cmpeq_epi8(v, cr)));
+                u32 mask = ~static_cast<u32>(_mm_movemask_epi8(m)) & 0xFFFFU;
+                if(0 != mask){
+                    return pos + countTrailingZeros(mask);
+                }
+            }
+        }
+#endif
+        while(pos<end && isJSONSpace(data[pos])){
+            ++pos;
+        }
+        return pos;
+    }
+
+    /**
+    @return Position of the first byte in [pos, end) which needs to be checked one by one,
+    a double quote, an escape, a tab, a line feed or a part of a multibyte character.
+    */
+    off_t scanPlainString(const u8* data, off_t pos, off_t end)
+    {
+#ifdef CPPGLTF_AVX2
+        {
+            const __m256i dquote = _mm256_set1_epi8('"');
+            const __m256i escape = _mm256_set1_epi8('\\');
+            const __m256i tab = _mm256_set1_epi8('\t');
+            const __m256i lf = _mm256_set1_epi8('\n');
+            for(; pos+32<=end; pos+=32){
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data+pos));
+                __m256i m = _mm256_or_si256(
+                    _mm256_or_si256(_mm256_cmpeq_epi8(v, dquote), _mm256_cmpeq_epi8(v, escape)),
+                    _mm256_or_si256(_mm256_cmpeq_epi8(v, tab), _mm256_cmpeq_epi8(v, lf)));
+                u32 mask = static_cast<u32>(_mm256_movemask_epi8(_mm256_or_si256(m, v)));
+                if(0 != mask){
+                    return pos + countTrailingZeros(mask);
+                }
+            }
+        }
+#endif
+#ifdef CPPGLTF_SSE2
+        {
+            const __m128i dquote = _mm_set1_epi8('"');
+            const __m128i escape = _mm_set1_epi8('\\');
+            const __m128i tab = _mm_set1_epi8('\t');
+            const __m128i lf = _mm_set1_epi8('\n');
+            for(; pos+16<=end; pos+=16){
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data+pos));
+                __m128i m = _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(v, dquote), _mm_cmpeq_epi8(v, escape)),
+                    _mm_or_si128(_mm_cmpeq_epi8(v, tab), _mm_cmpeq_epi8(v, lf)));
+                u32 mask = static_cast<u32>(_mm_movemask_epi8(_mm_or_si128(m, v)));
+                if(0 != mask){
+                    return pos + countTrailingZeros(mask);
+                }
+            }
+        }
+#endif
+        while(pos<end && isPlainStringChar(data[pos])){
+            ++pos;
+        }
+        return pos;
+    }
+
+    inline boolean isStructuralChar(u8 c)
+    {
+        return '{'==c || '}'==c || '['==c || ']'==c || '"'==c;
+    }
+
+    /**
+    @return Position of the first bracket or double quote in [pos, end)
+    */
+    off_t scanStructural(const u8* data, off_t pos, off_t end)
+    {
+#ifdef CPPGLTF_AVX2
+        {
+            //'{' and '}' are 0x7B and 0x7D, '[' and ']' are 0x5B and 0x5D
+            const __m256i bracket = _mm256_set1_epi8(0x5B);
+            const __m256i mask20 = _mm256_set1_epi8(~0x20);
+            const __m256i close = _mm256_set1_epi8(0x5D);
+            const __m256i dquote = _mm256_set1_epi8('"');
+            for(; pos+32<=end; pos+=32){
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data+pos));
+                __m256i u = _mm256_and_si256(v, mask20);
+                __m256i m = _mm256_or_si256(
+                    _mm256_or_si256(_mm256_cmpeq_epi8(u, bracket), _mm256_cmpeq_epi8(u, close)),
+                    _mm256_cmpeq_epi8(v, dquote));
+                u32 mask = static_cast<u32>(_mm256_movemask_epi8(m));
+                if(0 != mask){
+                    return pos + countTrailingZeros(mask);
+                }
+            }
+        }
+#endif
+#ifdef CPPGLTF_SSE2
+        {
+            const __m128i bracket = _mm_set1_epi8(0x5B);
+            const __m128i mask20 = _mm_set1_epi8(~0x20);
+            const __m128i close = _mm_set1_epi8(0x5D);
+            const __m128i dquote = _mm_set1_epi8('"');
+            for(; pos+16<=end; pos+=16){
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data+pos));
+                __m128i u = _mm_and_si128(v, mask20);
+                __m128i m = _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(u, bracket), _mm_cmpeq_epi8(u, close)),
+                    _mm_cmpeq_epi8(v, dquote));
+                u32 mask = static_cast<u32>(_mm_movemask_epi8(m));
+                if(0 != mask){
+                    return pos + countTrailingZeros(mask);
+                }
+            }
+        }
+#endif
+        while(pos<end && !isStructuralChar(data[pos])){
+            ++pos;
+        }
+        return pos;
+    }
+
+    inline s32 countBits(u32 x)
+    {
+#ifdef _MSC_VER
+        //__popcnt needs a CPU with POPCNT
+        x = x - ((x>>1) & 0x55555555U);
+        x = (x & 0x33333333U) + ((x>>2) & 0x33333333U);
+        x = (x + (x>>4)) & 0x0F0F0F0FU;
+        return static_cast<s32>((x*0x01010101U)>>24);
+#else
+        return __builtin_popcount(x);
+#endif
+    }
+
+    /**
+    @return Number of line feeds in [pos, end)
+    @param lineStart ... position after the last line feed, or pos
+    */
+    off_t countLineFeeds(const u8* data, off_t pos, off_t end, off_t& lineStart)
+    {
+        off_t count = 0;
+        lineStart = pos;
+#ifdef CPPGLTF_SSE2
+        {
+            const __m128i lf = _mm_set1_epi8('\n');
+            for(; pos+16<=end; pos+=16){
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data+pos));
+                u32 mask = static_cast<u32>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, lf)));
+                if(0 != mask){
+                    count += countBits(mask);
+                    lineStart = pos + 32 - countLeadingZeros(static_cast<u64>(mask)<<32);
+                }
+            }
+        }
+#endif
+        for(; pos<end; ++pos){
+            if('\n' == data[pos]){
+                ++count;
+                lineStart = pos+1;
+            }
+        }
+        return count;
+    }
+}
+
+    //---------------------------------------------------------------
+    //---
+    //--- JSONReader
+    //---
+    //---------------------------------------------------------------
+    JSONReader::JSONReader(IStream& istream, JSONEventHandler& handler)
+        :flags_(0)
+        ,istream_(istream)
+        ,handler_(handler)
+        ,data_(CPPGLTF_NULL)
+        ,size_(0)
+        ,start_(0)
+        ,line_(0)
+        ,lineStart_(0)
+        ,prevLineStart_(0)
+    {}
+
+    JSONReader::~JSONReader()
+    {
+    }
+
+    boolean JSONReader::read(s32 flags)
+    {
+        handler_.begin();
+        flags_ = flags;
+        data_ = istream_.data();
+        size_ = (CPPGLTF_NULL != data_)? istream_.size() : 0;
+        start_ = istream_.tell();
+        line_ = 0;
+        lineStart_ = start_;
+        prevLineStart_ = start_;
+        Range value;
+        if(!skipSpace()){
+            if(istream_.isEOF()){
+                return true;
+            } else{
+                onError();
+                return false;
+            }
+        }
+        s32 type = getValue(value);
+        if(JSON_Error == type || (JSON_Array != type && JSON_Object != type)){
+            return false;
+        }
+
+        //while(!istream_.isEOF()){
+        //    s32 c = get();
+        //    if(c==EOF){
+        //        break;
+        //    }
+        //    if(!isspace(c)){
+        //        return false;
+        //    }
+        //}
+
+        handler_.root(type, getRange(value));
+        handler_.end();
+        return true;
+    }
+
+    boolean JSONReader::skipSpace()
+    {
+        if(CPPGLTF_NULL != data_){
+            off_t pos = istream_.tell();
+            for(;;){
+                pos = scanSpace(data_, pos, size_);
+                if(size_<=pos){
+                    istream_.seek(size_);
+                    return false;
+                }
+                if(!isspace(data_[pos])){
+                    break;
+                }
+                ++pos;
+            }
+            return istream_.seek(pos);
+        }
+        for(;;){
+            s32 c = get();
+            if(c<0){
+                return false;
+            }
+            if(!isspace(c)){
+                return EOF != unget(c);
+            }
+        }
+    }
+
+    boolean JSONReader::check(const s8* str)
     {
         CPPGLTF_ASSERT(CPPGLTF_NULL != str);
         while('\0' != *str){
-            s32 c = istream_.get();
+            s32 c = get();
             if(c<0){
                 return false;
             }
@@ -3263,38 +6055,14 @@ namespace
         }
         flags_ |= Flag_ErrorReported;
         off_t pos = istream_.tell();
-        if(!istream_.seek(0)){
-            handler_.onError(-1, -1);
-            return JSON_Error;
-        }
-
-        s32 line = 0;
-        s32 count = 0;
-        for(;;){
-            s32 c = istream_.get();
-            if(c == EOF){
-                break;
-            }
-            if(c == '\r'){
-                s32 c1 = istream_.get();
-                if(c1 != '\n'){
-                    if(EOF != c1){
-                        istream_.unget(c1);
-                    }
-                }
-                ++line;
-                count = 0;
-            }else if(c == '\n'){
-                ++line;
-                count = 0;
-            }else{
-                ++count;
-            }
-            if(istream_.tell() == pos){
-                break;
-            }
-        }
-        handler_.onError(line+1, count);
+        off_t line = line_;
+        off_t lineStart = lineStart_;
+        if(CPPGLTF_NULL != data_){
+            //Lines in a contiguous stream are counted only when needed, because the fast paths jump over them
+            pos = (size_<pos)? size_ : pos;
+            line = countLineFeeds(data_, start_, pos, lineStart);
+        }
+        handler_.onError(static_cast<s32>(line+1), static_cast<s32>(pos-lineStart));
         return JSON_Error;
     }
 
@@ -3310,14 +6078,14 @@ namespace
             if(!skipSpace()){
                 return onError();
             }
-            s32 c = istream_.get();
+            s32 c = get();
             switch(c){
             case JSONToken_OBJEnd:
                 if(bSeparator && !bKeyValue){
                     return onError();
                 }
                 setLength(object);
-                handler_.endObject(RangeStream(&istream_, object));
+                handler_.endObject(getRange(object));
                 return JSON_OK;
 
             case JSONToken_DQuote:
@@ -3334,18 +6102,24 @@ namespace
                 if(!skipSpace()){
                     return onError();
                 }
-                if(JSONToken_OBJColon != istream_.get()){
+                if(JSONToken_OBJColon != get()){
                     return onError();
                 }
                 if(!skipSpace()){
                     return onError();
                 }
+                if(!handler_.key(getRange(key))){
+                    if(JSON_Error == skipValue()){
+                        return JSON_Error;
+                    }
+                    break;
+                }
                 Range value;
                 s32 type = getValue(value);
                 if(JSON_Error == type){
                     return JSON_Error;
                 }
-                handler_.keyValue(RangeStream(&istream_, key), type, RangeStream(&istream_, value));
+                handler_.keyValue(getRange(key), type, getRange(value));
             }
             break;
             case JSONToken_Separator:
@@ -3368,14 +6142,14 @@ namespace
         if(!skipSpace()){
             return onError();
         }
-        s32 c = istream_.get();
+        s32 c = get();
         if(c<0){
             return onError();
         }
         switch(c){
         case JSONToken_ArrayEnd:
             setLength(array);
-            handler_.endArray(RangeStream(&istream_, array));
+            handler_.endArray(getRange(array));
             return JSON_OK;
         case JSONToken_Separator:
             return onError();
@@ -3391,7 +6165,7 @@ namespace
                     return onError();
                 }
                 setLength(array);
-                handler_.endArray(RangeStream(&istream_, array));
+                handler_.endArray(getRange(array));
                 return JSON_OK;
             case JSONToken_Separator:
                 if(JSONToken_Separator == prev){
@@ -3404,7 +6178,7 @@ namespace
                     return onError();
                 }
                 prev = JSONToken_Value;
-                if(EOF == istream_.unget(c)){
+                if(EOF == unget(c)){
                     return onError();
                 }
                 Range value;
@@ -3412,13 +6186,13 @@ namespace
                 if(JSON_Error == type){
                     return JSON_Error;
                 }
-                handler_.value(type, RangeStream(&istream_, value));
+                handler_.value(type, getRange(value));
                 break;
             }
             if(!skipSpace()){
                 return onError();
             }
-            c = istream_.get();
+            c = get();
             if(c==EOF){
                 return onError();
             }
@@ -3427,7 +6201,7 @@ namespace
 
     s32 JSONReader::getValue(Range& value)
     {
-        s32 c = istream_.get();
+        s32 c = get();
         if(c<0){
             return onError();
         }
@@ -3472,7 +6246,7 @@ namespace
             setLength(value);
             break;
         default:
-            if(EOF == istream_.unget(c)){
+            if(EOF == unget(c)){
                 return onError();
             }
             type = getNumber(value);
@@ -3485,7 +6259,14 @@ namespace
     {
         setStart(str);
         for(;;){
-            s32 c = istream_.get();
+            if(CPPGLTF_NULL != data_){
+                off_t pos = istream_.tell();
+                off_t next = scanPlainString(data_, pos, size_);
+                if(pos != next && !istream_.seek(next)){
+                    return onError();
+                }
+            }
+            s32 c = get();
             if(c<0){
                 return onError();
             }
@@ -3497,7 +6278,7 @@ namespace
                     setLength(str);
                     return JSON_String;
                 case JSONToken_Escape:
-                    c = istream_.get();
+                    c = get();
                     if(c<0){
                         return onError();
                     }
@@ -3536,7 +6317,7 @@ namespace
                 return onError();
             }
             for(s32 i=0; i<n; ++i){
-                c = istream_.get();
+                c = get();
                 if(c<0 || 2 != (c>>6)){
                     return onError();
                 }
@@ -3548,12 +6329,12 @@ namespace
     {
         setStart(number);
         s32 type = JSON_Integer;
-        s32 c = istream_.get();
+        s32 c = get();
         if(c<0){
             return onError();
         }
         if(c=='-'){
-            c = istream_.get();
+            c = get();
         }
         if(!isNumber(c)){
             return onError();
@@ -3563,9 +6344,9 @@ namespace
                 return JSON_Error;
             }
         }
-        c = istream_.get();
+        c = get();
         if(c == '.'){
-            c = istream_.get();
+            c = get();
             if(!isNumber(c)){
                 return onError();
             }
@@ -3573,18 +6354,18 @@ namespace
                 return JSON_Error;
             }
             type = JSON_Float;
-            c = istream_.get();
+            c = get();
         }
 
         if(c=='e' || c=='E'){
-            c = istream_.get();
+            c = get();
             if(c=='+'||c=='-'){
-                c = istream_.get();
+                c = get();
             }
             if(!isNumber(c)){
                 return onError();
             }
-            istream_.unget(c);
+            unget(c);
             c = getDigit(false);
             if(JSON_Error == c){
                 return JSON_Error;
@@ -3594,20 +6375,20 @@ namespace
             return onError();
         }
         setLength(number);
-        return (EOF != istream_.unget(c))? type : onError();
+        return (EOF != unget(c))? type : onError();
     }
 
     s32 JSONReader::getDigit(boolean unget)
     {
         s32 c;
         for(;;){
-            c = istream_.get();
+            c = get();
             if(EOF==c){
                 return onError();
             }
             if(!isNumber(c)){
                 if(unget){
-                    return (EOF != istream_.unget(c))? JSON_OK : onError();
+                    return (EOF != JSONReader::unget(c))? JSON_OK : onError();
                 }
                 break;
             }
@@ -3624,6 +6405,96 @@ namespace
         return ('1'<=c && c<='9');
     }
 
+    s32 JSONReader::skipValue()
+    {
+        s32 c = get();
+        if(c<0){
+            return onError();
+        }
+        if(JSONToken_OBJStart != c && JSONToken_ArrayStart != c){
+            if(EOF == unget(c)){
+                return onError();
+            }
+            Range value;
+            return getValue(value);
+        }
+        s32 type = (JSONToken_OBJStart == c)? JSON_Object : JSON_Array;
+        s32 depth = 1;
+        boolean inString = false;
+        if(CPPGLTF_NULL != data_){
+            off_t pos = istream_.tell();
+            while(pos<size_){
+                if(inString){
+                    pos = scanPlainString(data_, pos, size_);
+                    if(size_<=pos){
+                        break;
+                    }
+                    switch(data_[pos]){
+                    case JSONToken_DQuote:
+                        inString = false;
+                        break;
+                    case JSONToken_Escape:
+                        ++pos;
+                        break;
+                    }
+                    ++pos;
+                    continue;
+                }
+                pos = scanStructural(data_, pos, size_);
+                if(size_<=pos){
+                    break;
+                }
+                switch(data_[pos]){
+                case JSONToken_DQuote:
+                    inString = true;
+                    break;
+                case JSONToken_OBJStart:
+                case JSONToken_ArrayStart:
+                    ++depth;
+                    break;
+                default:
+                    --depth;
+                    break;
+                }
+                ++pos;
+                if(depth<=0){
+                    return istream_.seek(pos)? type : onError();
+                }
+            }
+            istream_.seek(size_);
+            return onError();
+        }
+        for(;;){
+            c = get();
+            if(c<0){
+                return onError();
+            }
+            if(inString){
+                if(JSONToken_DQuote == c){
+                    inString = false;
+                }else if(JSONToken_Escape == c && get()<0){
+                    return onError();
+                }
+                continue;
+            }
+            switch(c){
+            case JSONToken_DQuote:
+                inString = true;
+                break;
+            case JSONToken_OBJStart:
+            case JSONToken_ArrayStart:
+                ++depth;
+                break;
+            case JSONToken_OBJEnd:
+            case JSONToken_ArrayEnd:
+                if(--depth<=0){
+                    return type;
+                }
+                break;
+            }
+        }
+    }
+
     //---------------------------------------------------------------
     //---
     //--- glTF JSON
@@ -3698,12 +6569,15 @@ namespace
 
     Allocator::Allocator()
         :large_(CPPGLTF_NULL)
-        ,top_(CPPGLTF_NULL)
+        ,pages_(CPPGLTF_NULL)
+        ,freePages_(CPPGLTF_NULL)
         ,largeTop_(CPPGLTF_NULL)
+        ,pageUsed_(UnitNum)
     {
         for(s32 i=0; i<TableSize; ++i){
             table_[i] = CPPGLTF_NULL;
         }
+        ::memset(&stats_, 0, sizeof(Stats));
     }
 
     Allocator::~Allocator()
@@ -3717,16 +6591,45 @@ namespace
             table_[i] = CPPGLTF_NULL;
         }
         large_ = CPPGLTF_NULL;
-        while(CPPGLTF_NULL != top_){
-            Page* next = top_->next_;
-            CPPGLTF_FREE(top_);
-            top_ = next;
+        pageUsed_ = UnitNum;
+        while(CPPGLTF_NULL != pages_){
+            Page* next = pages_->next_;
+            CPPGLTF_FREE(pages_);
+            pages_ = next;
+        }
+        while(CPPGLTF_NULL != freePages_){
+            Page* next = freePages_->next_;
+            CPPGLTF_FREE(freePages_);
+            freePages_ = next;
         }
         while(CPPGLTF_NULL != largeTop_){
             Page* next = largeTop_->next_;
             CPPGLTF_FREE(largeTop_);
             largeTop_ = next;
         }
+        ::memset(&stats_, 0, sizeof(Stats));
+    }
+
+    void Allocator::reset()
+    {
+        for(s32 i=0; i<TableSize; ++i){
+            table_[i] = CPPGLTF_NULL;
+        }
+        pageUsed_ = UnitNum;
+        while(CPPGLTF_NULL != pages_){
+            Page* next = pages_->next_;
+            pages_->next_ = freePages_;
+            freePages_ = pages_;
+            pages_ = next;
+        }
+        large_ = CPPGLTF_NULL;
+        for(Page* top = largeTop_; CPPGLTF_NULL != top; top = top->next_){
+            Page* page = &((PageMem*)top+1)->page_;
+            page->capacity_ = top->capacity_;
+            page->next_ = large_;
+            large_ = page;
+        }
+        stats_.used_ = 0;
     }
 
     void* Allocator::alloc(s32 num)
@@ -3744,24 +6647,7 @@ namespace
             return allocate(SmaleSizes[index]);
 
         }else{
-            Page* prev = CPPGLTF_NULL;
-            Page* page = large_;
-            while(CPPGLTF_NULL != page){
-                if(num<=large_->capacity_){
-                    if(page == large_){
-                        large_ = large_->next_;
-                    }else{
-                        prev->next_ = page->next_;
-                    }
-                    return page;
-                }
-            }
-            PageMem* top = (PageMem*)CPPGLTF_MALLOC(UnitSize*(num+1));
-            top->page_.capacity_ = 0;
-            page = &(top+1)->page_;
-            top->page_.next_ = largeTop_;
-            largeTop_ = &(top->page_);
-            return page;
+            return allocateLarge(num);
         }
     }
 
@@ -3771,176 +6657,266 @@ namespace
             return;
         }
         Page* page = (Page*)ptr;
-        page->capacity_ = num;
         if(num<=MaxNum){
             s32 index = 0;
             for(;SmaleSizes[index]<num;++index){
             }
+            page->capacity_ = SmaleSizes[index];
             page->next_ = table_[index];
             table_[index] = page;
         }else{
+            Page* top = &((PageMem*)ptr-1)->page_;
+            page->capacity_ = top->capacity_;
             page->next_ = large_;
             large_ = page;
+            addUsed(-static_cast<s64>(UnitSize)*(top->capacity_+1));
         }
     }
 
     void* Allocator::allocate(s32 num)
+    {
+        if((UnitNum-pageUsed_)<num){
+            if(CPPGLTF_NULL != pages_){
+                release((PageMem*)pages_+pageUsed_, UnitNum-pageUsed_);
+            }
+            Page* page = freePages_;
+            if(CPPGLTF_NULL != page){
+                freePages_ = page->next_;
+            }else{
+                page = (Page*)CPPGLTF_MALLOC(UnitSize*UnitNum);
+                page->capacity_ = UnitNum;
+                stats_.reserved_ += UnitSize*UnitNum;
+                ++stats_.numPages_;
+            }
+            page->next_ = pages_;
+            pages_ = page;
+            pageUsed_ = 1;
+            addUsed(UnitSize*UnitNum);
+        }
+        void* ptr = (PageMem*)pages_+pageUsed_;
+        pageUsed_ += num;
+        return ptr;
+    }
+
+    void* Allocator::allocateLarge(s32 num)
     {
         Page* prev = CPPGLTF_NULL;
-        Page* page = top_;
-        while(CPPGLTF_NULL != page){
+        for(Page* page = large_; CPPGLTF_NULL != page; prev = page, page = page->next_){
             if(num<=page->capacity_){
-                s32 capacity = page->capacity_-num;
-                s32 d = UnitNum-page->capacity_;
-                if(0==capacity){
-                    if(page == top_){
-                        top_ = top_->next_;
-                    } else{
-                        prev->next_ = page->next_;
-                    }
+                if(CPPGLTF_NULL == prev){
+                    large_ = page->next_;
+                }else{
+                    prev->next_ = page->next_;
                 }
-                page->capacity_ = capacity;
-                return &((PageMem*)page+d)->page_;
+                addUsed(static_cast<s64>(UnitSize)*(page->capacity_+1));
+                return page;
+            }
+        }
+        PageMem* top = (PageMem*)CPPGLTF_MALLOC(UnitSize*(num+1));
+        top->page_.capacity_ = num;
+        top->page_.next_ = largeTop_;
+        largeTop_ = &(top->page_);
+        stats_.reserved_ += static_cast<s64>(UnitSize)*(num+1);
+        ++stats_.numLarges_;
+        addUsed(static_cast<s64>(UnitSize)*(num+1));
+        return &(top+1)->page_;
+    }
+
+    void Allocator::release(PageMem* mem, s32 num)
+    {
+        //Split the rest of a page into blocks of the size classes
+        s32 index = TableSize-1;
+        while(0<num){
+            while(num<SmaleSizes[index]){
+                --index;
             }
-            prev = page;
-            page = page->next_;
+            Page* page = &mem->page_;
+            page->capacity_ = SmaleSizes[index];
+            page->next_ = table_[index];
+            table_[index] = page;
+            mem += SmaleSizes[index];
+            num -= SmaleSizes[index];
         }
+    }
 
-        PageMem* top = (PageMem*)CPPGLTF_MALLOC(UnitSize*UnitNum);
-        top->page_.capacity_ = UnitNum-num-1;
-        page = &(top+1)->page_;
-        top->page_.next_ = top_;
-        top_ = &(top->page_);
-        return page;
+    void Allocator::addUsed(s64 size)
+    {
+        stats_.used_ += size;
+        if(stats_.peak_<stats_.used_){
+            stats_.peak_ = stats_.used_;
+        }
     }
 
     namespace
     {
-        struct Word{ u32 hash_; const char* str_;};
+        struct Word{ s32 code_; s32 length_; const char* str_;};
         static const s32 NumWords = 113;
-        const Word words[] =
+        static const s32 NumKeyBuckets = 29;
+        constexpr u16 keyDisplacements[NumKeyBuckets] =
         {
-            {3733770766U,"BUFFERVIEW"},
-            {1736982884U,"BYTEOFFSET"},
-            {535965544U,"COMPONENTTYPE"},
-            {759490392U,"NORMALIZED"},
-            {2750919380U,"COUNT"},
-            {338683789U,"TYPE"},
-            {475632249U,"MAX"},
-            {239465655U,"MIN"},
-            {413982885U,"SPARSE"},
-            {1387956774U,"NAME"},
-            {1482583691U,"EXTENSIONS"},
-            {1617560430U,"EXTRAS"},
-            {2180989045U,"CHANNELS"},
-            {864986484U,"SAMPLERS"},
-            {1638025307U,"INPUT"},
-            {3457493885U,"INTERPOLATION"},
-            {1469629700U,"OUTPUT"},
-            {2970901150U,"COPYRIGHT"},
-            {622175778U,"GENERATOR"},
-            {3552295351U,"VERSION"},
-            {3706427545U,"MINVERSION"},
-            {2053729053U,"URI"},
-            {1037972015U,"BYTELENGTH"},
-            {4289874747U,"BUFFER"},
-            {417073434U,"BYTESTRIDE"},
-            {4080126536U,"TARGET"},
-            {4050703019U,"ORTHOGRAPHIC"},
-            {2423545653U,"PERSPECTIVE"},
-            {4060151151U,"SAMPLER"},
-            {1499262730U,"EXTENSIONSUSED"},
-            {996948758U,"EXTENSIONSREQUIRED"},
-            {2414822891U,"ACCESSORS"},
-            {1789696170U,"ANIMATIONS"},
-            {2283815739U,"ASSET"},
-            {3987518648U,"BUFFERS"},
-            {3031378023U,"BUFFERVIEWS"},
-            {2550069799U,"CAMERAS"},
-            {1881178923U,"IMAGES"},
-            {1393374089U,"MATERIALS"},
-            {4206430392U,"MESHES"},
-            {3675200826U,"NODES"},
-            {51960179U,"SCENE"},
-            {1953120U,"SCENES"},
-            {1702551537U,"SKINS"},
-            {3346351557U,"TEXTURES"},
-            {3540378101U,"MIMETYPE"},
-            {2464862628U,"PBRMETALLICROUGHNESS"},
-            {3405345669U,"NORMALTEXTURE"},
-            {1228653941U,"OCCLUSIONTEXTURE"},
-            {3330026097U,"EMISSIVETEXTURE"},
-            {2025219817U,"EMISSIVEFACTOR"},
-            {3200287092U,"ALPHAMODE"},
-            {2113210782U,"ALPHACUTOFF"},
-            {1515629509U,"DOUBLESIDED"},
-            {3884336095U,"PRIMITIVES"},
-            {3302258910U,"WEIGHTS"},
-            {1150800334U,"CAMERA"},
-            {25294226U,"CHILDREN"},
-            {1891474104U,"SKIN"},
-            {3232719852U,"MATRIX"},
-            {1253731580U,"MESH"},
-            {1306169695U,"ROTATION"},
-            {594488785U,"SCALE"},
-            {2352925580U,"TRANSLATION"},
-            {2977188619U,"INDEX"},
-            {197415955U,"TEXCOORD"},
-            {1190385072U,"STRENGTH"},
-            {2641395134U,"XMAG"},
-            {4266306379U,"YMAG"},
-            {3102316870U,"ZFAR"},
-            {3547621959U,"ZNEAR"},
-            {1281948832U,"BASECOLORFACTOR"},
-            {2523291950U,"BASECOLORTEXTURE"},
-            {3732260891U,"METALLICFACTOR"},
-            {3032623030U,"ROUGHNESSFACTOR"},
-            {3979861821U,"METALLICROUGHNESSTEXTURE"},
-            {770814808U,"ASPECTRATIO"},
-            {3573915575U,"YFOV"},
-            {2183160468U,"ATTRIBUTES"},
-            {3304816210U,"INDICES"},
-            {2401933216U,"MATERIAL"},
-            {3593007890U,"MODE"},
-            {4066453633U,"TARGETS"},
-            {2867472150U,"MAGFILTER"},
-            {2384703633U,"MINFILTER"},
-            {3322193538U,"WRAPS"},
-            {3238305443U,"WRAPT"},
-            {622090976U,"INVERSEBINDMATRICES"},
-            {4266997486U,"SKELETON"},
-            {1803683916U,"JOINTS"},
-            {3612181627U,"VALUES"},
-            {2000820813U,"NODE"},
-            {1839435638U,"PATH"},
-            {3111715480U,"SOURCE"},
-            {2013849738U,"POSITION"},
-            {1009949074U,"NORMAL"},
-            {2576630498U,"TANGENT"},
-            {1145745916U,"TEXCOORD_0"},
-            {1162523535U,"TEXCOORD_1"},
-            {1179301154U,"TEXCOORD_2"},
-            {1196078773U,"TEXCOORD_3"},
-            {3429632335U,"COLOR_0"},
-            {3412854716U,"COLOR_1"},
-            {3463187573U,"COLOR_2"},
-            {3446409954U,"COLOR_3"},
-            {3797173403U,"JOINTS_0"},
-            {3780395784U,"JOINTS_1"},
-            {3830728641U,"JOINTS_2"},
-            {3813951022U,"JOINTS_3"},
-            {596967449U,"WEIGHTS_0"},
-            {580189830U,"WEIGHTS_1"},
-            {563412211U,"WEIGHTS_2"},
-            {546634592U,"WEIGHTS_3"},
+            20U, 70U, 22U, 64U, 4U, 16U, 2U, 20U,
+            17U, 1U, 12U, 38U, 47U, 1U, 10U, 66U,
+            102U, 8U, 17U, 22U, 447U, 37U, 86U, 108U,
+            33U, 4328U, 3U, 1620U, 176U,
+        };
+        //Sorted by slots of the perfect hash
+        constexpr Word words[NumWords] =
+        {
+            {76,11,"aspectRatio"},
+            {80,8,"material"},
+            {99,10,"TEXCOORD_2"},
+            {4,5,"count"},
+            {67,4,"xmag"},
+            {24,10,"byteStride"},
+            {60,4,"mesh"},
+            {84,9,"minFilter"},
+            {111,9,"WEIGHTS_2"},
+            {92,4,"path"},
+            {3,10,"normalized"},
+            {46,20,"pbrMetallicRoughness"},
+            {7,3,"min"},
+            {89,6,"joints"},
+            {33,5,"asset"},
+            {90,6,"values"},
+            {13,8,"samplers"},
+            {45,8,"mimeType"},
+            {109,9,"WEIGHTS_0"},
+            {20,10,"minVersion"},
+            {10,10,"extensions"},
+            {53,11,"doubleSided"},
+            {55,7,"weights"},
+            {25,6,"target"},
+            {70,5,"znear"},
+            {49,15,"emissiveTexture"},
+            {58,4,"skin"},
+            {62,5,"scale"},
+            {98,10,"TEXCOORD_1"},
+            {69,4,"zfar"},
+            {105,8,"JOINTS_0"},
+            {51,9,"alphaMode"},
+            {57,8,"children"},
+            {100,10,"TEXCOORD_3"},
+            {77,4,"yfov"},
+            {103,7,"COLOR_2"},
+            {108,8,"JOINTS_3"},
+            {22,10,"byteLength"},
+            {75,24,"metallicRoughnessTexture"},
+            {56,6,"camera"},
+            {112,9,"WEIGHTS_3"},
+            {72,16,"baseColorTexture"},
+            {52,11,"alphaCutoff"},
+            {74,15,"roughnessFactor"},
+            {14,5,"input"},
+            {15,13,"interpolation"},
+            {86,5,"wrapT"},
+            {2,13,"componentType"},
+            {104,7,"COLOR_3"},
+            {78,10,"attributes"},
+            {18,9,"generator"},
+            {91,4,"node"},
+            {66,8,"strength"},
+            {30,18,"extensionsRequired"},
+            {21,3,"uri"},
+            {27,11,"perspective"},
+            {23,6,"buffer"},
+            {88,8,"skeleton"},
+            {8,6,"sparse"},
+            {102,7,"COLOR_1"},
+            {94,8,"POSITION"},
+            {32,10,"animations"},
+            {59,6,"matrix"},
+            {63,11,"translation"},
+            {79,7,"indices"},
+            {17,9,"copyright"},
+            {54,10,"primitives"},
+            {48,16,"occlusionTexture"},
+            {39,6,"meshes"},
+            {35,11,"bufferViews"},
+            {36,7,"cameras"},
+            {87,19,"inverseBindMatrices"},
+            {81,4,"mode"},
+            {11,6,"extras"},
+            {85,5,"wrapS"},
+            {82,7,"targets"},
+            {5,4,"type"},
+            {107,8,"JOINTS_2"},
+            {41,5,"scene"},
+            {16,6,"output"},
+            {38,9,"materials"},
+            {47,13,"normalTexture"},
+            {29,14,"extensionsUsed"},
+            {93,6,"source"},
+            {42,6,"scenes"},
+            {61,8,"rotation"},
+            {73,14,"metallicFactor"},
+            {40,5,"nodes"},
+            {97,10,"TEXCOORD_0"},
+            {37,6,"images"},
+            {31,9,"accessors"},
+            {19,7,"version"},
+            {1,10,"byteOffset"},
+            {106,8,"JOINTS_1"},
+            {96,7,"TANGENT"},
+            {12,8,"channels"},
+            {68,4,"ymag"},
+            {65,8,"texCoord"},
+            {101,7,"COLOR_0"},
+            {34,7,"buffers"},
+            {26,12,"orthographic"},
+            {28,7,"sampler"},
+            {110,9,"WEIGHTS_1"},
+            {43,5,"skins"},
+            {44,8,"textures"},
+            {9,4,"name"},
+            {71,15,"baseColorFactor"},
+            {50,14,"emissiveFactor"},
+            {0,10,"bufferView"},
+            {64,5,"index"},
+            {6,3,"max"},
+            {95,6,"NORMAL"},
+            {83,9,"magFilter"},
         };
-    }
 
-    //---------------------------------------------------------------
-    //---
-    //--- glTFBase
-    //---
-    //---------------------------------------------------------------
+        constexpr u32 hashKey(const char* str, u32 hash=2166136261U)
+        {
+            return '\0' == *str? hash : hashKey(str+1, (hash ^ static_cast<u8>(*str)) * 16777619U);
+        }
+
+        constexpr u32 foldKey(u32 x)
+        {
+            return (x ^ (x>>16)) * 0x85EBCA6BU;
+        }
+
+        /**
+        @brief Must be the same as displaceKey in tools/KeyGenerator.cpp
+        */
+        constexpr u32 displaceKey(u32 hash, u32 displacement)
+        {
+            return foldKey(hash ^ (displacement*0x9E3779B9U)) ^ (foldKey(hash ^ (displacement*0x9E3779B9U))>>13);
+        }
+
+        constexpr s32 keySlot(u32 hash)
+        {
+            return static_cast<s32>(displaceKey(hash, keyDisplacements[hash%NumKeyBuckets])%NumWords);
+        }
+
+        constexpr s32 keyLength(const char* str)
+        {
+            return '\0' == *str? 0 : 1+keyLength(str+1);
+        }
+
+        constexpr boolean checkWords(s32 i)
+        {
+            return NumWords<=i || (i == keySlot(hashKey(words[i].str_)) && words[i].length_ == keyLength(words[i].str_) && checkWords(i+1));
+        }
+        static_assert(checkWords(0), "keys.cpp is not a perfect hash of words, regenerate it with tools/KeyGenerator.cpp");
+    }
+
+    //---------------------------------------------------------------
+    //---
+    //--- glTFBase
+    //---
+    //---------------------------------------------------------------
 
     //--- glTFBase::StringTable
     //---------------------------------------------------------------
@@ -3981,6 +6957,12 @@ namespace
         return start;
     }
 
+    void glTFBase::StringTable::truncate(s32 length)
+    {
+        CPPGLTF_ASSERT(0<=length && length<=length_);
+        length_ = length;
+    }
+
     const Char* glTFBase::StringTable::c_str(s32 start) const
     {
         return strings_+start;
@@ -3997,6 +6979,11 @@ namespace
         :size_(0)
         ,capacity_(0)
         ,elements_(CPPGLTF_NULL)
+        ,flags_(0)
+        ,skipSections_(0)
+        ,section_(-1)
+        ,sectionStrings_(0)
+        ,sectionIndex_(0)
     {
     }
 
@@ -4007,7 +6994,7 @@ namespace
 
     void glTFBase::begin()
     {
-        destroy();
+        clear();
     }
 
     void glTFBase::end()
@@ -4016,18 +7003,21 @@ namespace
 
     void glTFBase::destroy()
     {
+        clear();
+        allocator_.destroy();
+    }
+
+    void glTFBase::clear()
+    {
+        section_ = -1;
+        sectionStrings_ = 0;
+        sectionIndex_ = 0;
         strings_.clear();
         key_.clear();
-        if(CPPGLTF_NULL != elements_){
-            for(s32 i = 0; i<size_; ++i){
-                JSElement::destroy(allocator_, elements_[i]);
-            }
-            allocator_.dealloc(capacity_, elements_);
-            size_ = 0;
-            capacity_ = 0;
-            elements_ = CPPGLTF_NULL;
-        }
-        allocator_.destroy();
+        size_ = 0;
+        capacity_ = 0;
+        elements_ = CPPGLTF_NULL;
+        allocator_.reset();
     }
 
     void glTFBase::beginObject()
@@ -4102,12 +7092,11 @@ namespace
             v.readAsString(strings_.c_str(val.string_));
             break;
         case JSON_Integer:
-            val.type_ = JSON_Integer;
-            val.int_ = v.readAsInt();
+            setInteger(val, v);
             break;
         case JSON_Float:
             val.type_ = JSON_Float;
-            val.float_ = v.readAsFloat();
+            val.float_ = v.readAsDouble();
             break;
         case JSON_True:
             val.type_ = JSON_True;
@@ -4122,6 +7111,16 @@ namespace
             CPPGLTF_ASSERT(false);
             break;
         }
+
+        //An element of a top-level array
+        if(0<=section_ && 2 == size_){
+            if(parseElement(section_, sectionIndex_, val)){
+                JSAny::destroy(allocator_, val);
+                --element.value_.num_;
+                strings_.truncate(sectionStrings_);
+            }
+            ++sectionIndex_;
+        }
     }
 
     void glTFBase::keyValue(RangeStream key, s32 type, RangeStream value)
@@ -4134,15 +7133,15 @@ namespace
         CPPGLTF_ASSERT(JSON_Object == element.value_.type_);
         expandObject(element);
 
-        key.readAsString(key_);
-        for(s32 i=0; i<key_.length(); ++i){
-            key_[i] = (Char)toupper(key_[i]);
-        }
-
         JSKeyValue& keyValue = element.value_.object_[element.value_.num_];
         ++element.value_.num_;
 
-        keyValue.key_ = getKeyCode(key_);
+        if(CPPGLTF_NULL != key.data()){
+            keyValue.key_ = getKeyCode(key.length(), key.data());
+        }else{
+            key.readAsString(key_);
+            keyValue.key_ = getKeyCode(key_);
+        }
         JSAny& val = keyValue.value_;
         switch(type){
         case JSON_Object:
@@ -4156,18 +7155,23 @@ namespace
             val = elements_[size_].value_;
             break;
         case JSON_String:
+            if(GLTF_URI == keyValue.key_ && isDataURI(value)){
+                val.type_ = JSON_Source;
+                val.num_ = value.length();
+                val.source_ = value.data();
+                break;
+            }
             val.type_ = JSON_String;
             val.num_ = value.length();
             val.string_ = strings_.add(value.length());
             value.readAsString(strings_.c_str(val.string_));
             break;
         case JSON_Integer:
-            val.type_ = JSON_Integer;
-            val.int_ = value.readAsInt();
+            setInteger(val, value);
             break;
         case JSON_Float:
             val.type_ = JSON_Float;
-            val.float_ = value.readAsFloat();
+            val.float_ = value.readAsDouble();
             break;
         case JSON_True:
             val.type_ = JSON_True;
@@ -4183,6 +7187,35 @@ namespace
             break;
         }
     }
+    boolean glTFBase::key(RangeStream key)
+    {
+        if(1 != size_ || (0 == skipSections_ && Flag_Streaming != (flags_&Flag_Streaming))){
+            return true;
+        }
+        s32 code;
+        if(CPPGLTF_NULL != key.data()){
+            code = getKeyCode(key.length(), key.data());
+        }else{
+            key.readAsString(key_);
+            code = getKeyCode(key_);
+        }
+        if(0 != (skipSections_&getSectionFlag(code))){
+            section_ = -1;
+            return false;
+        }
+        if(Flag_Streaming == (flags_&Flag_Streaming)){
+            section_ = code;
+            sectionStrings_ = strings_.size();
+            sectionIndex_ = 0;
+        }
+        return true;
+    }
+
+    boolean glTFBase::parseElement(s32 /*key*/, s32 /*index*/, const JSAny& /*value*/)
+    {
+        return false;
+    }
+
 #ifdef _DEBUG
     void glTFBase::onError(s32 line, s32 charCount)
     {
@@ -4197,17 +7230,6 @@ namespace
 
     namespace
     {
-        u32 hash_FNV1a(const u8* v, u32 count)
-        {
-            u32 hash = 2166136261U;
-
-            for(u32 i=0; i<count; ++i){
-                hash ^= v[i];
-                hash *= 16777619U;
-            }
-            return hash;
-        }
-
         s32 getNextSize(s32 size)
         {
             if(size<=Allocator::MaxNum){
@@ -4259,15 +7281,65 @@ namespace
         element.value_.array_ = values;
     }
 
+    boolean glTFBase::equals(const JSAny& value, const Char* str) const
+    {
+        CPPGLTF_ASSERT(CPPGLTF_NULL != str);
+        if(JSON_String != value.type_){
+            return false;
+        }
+        const Char* s = strings_.c_str(value.string_);
+        s32 i=0;
+        for(; i<value.num_; ++i){
+            if(s[i] != str[i]){
+                return false;
+            }
+        }
+        return '\0' == str[i];
+    }
+
     void glTFBase::getString(String& str, const JSAny& value) const
     {
         str.clear();
+        if(JSON_Source == value.type_){
+            str.assign(value.num_, value.source_);
+            return;
+        }
         if(JSON_String != value.type_){
             return;
         }
         str.assign(value.num_, strings_.c_str(value.string_));
     }
 
+    boolean glTFBase::isDataURI(const RangeStream& value)
+    {
+        static const Char DataScheme[] = "data:";
+        static const s32 DataSchemeLength = sizeof(DataScheme)-1;
+        const Char* data = value.data();
+        if(CPPGLTF_NULL == data || value.length()<DataSchemeLength || 0 != ::memcmp(data, DataScheme, DataSchemeLength)){
+            return false;
+        }
+        //Escaped characters need to be unescaped into the string table
+        return CPPGLTF_NULL == ::memchr(data, '\\', value.length());
+    }
+
+    void glTFBase::setInteger(JSAny& value, RangeStream& token)
+    {
+        //Tokens of up to 18 characters always fit in 64 bits, longer ones become the nearest doubles
+        if(18<token.length()){
+            value.type_ = JSON_Float;
+            value.float_ = token.readAsDouble();
+            return;
+        }
+        s64 x = token.readAsInt64();
+        if(x<INT32_MIN || INT32_MAX<x){
+            value.type_ = JSON_Float;
+            value.float_ = static_cast<f64>(x);
+        }else{
+            value.type_ = JSON_Integer;
+            value.int_ = static_cast<s32>(x);
+        }
+    }
+
     bool glTFBase::getBoolean(const JSAny& value) const
     {
         CPPGLTF_ASSERT(JSON_True==value.type_ || JSON_False==value.type_);
@@ -4277,7 +7349,12 @@ namespace
     f32 glTFBase::getNumber(const JSAny& value) const
     {
         CPPGLTF_ASSERT(JSON_Integer==value.type_ || JSON_Float==value.type_);
-        return JSON_Integer == value.type_? static_cast<f32>(value.int_) : value.float_;
+        return JSON_Integer == value.type_? static_cast<f32>(value.int_) : static_cast<f32>(value.float_);
+    }
+
+    s64 glTFBase::getInteger(const JSAny& value) const
+    {
+        return JSON_Float == value.type_? static_cast<s64>(value.float_) : static_cast<s64>(value.int_);
     }
 
     void glTFBase::getNumbers(s32 num, Number* x, const JSAny& value) const
@@ -4333,15 +7410,69 @@ namespace
         }
     }
 
+    u32 glTFBase::getSectionFlag(s32 key)
+    {
+        switch(key){
+        case GLTF_EXTENSIONSUSED:
+            return GLTF_SECTION_EXTENSIONSUSED;
+        case GLTF_EXTENSIONSREQUIRED:
+            return GLTF_SECTION_EXTENSIONSREQUIRED;
+        case GLTF_ACCESSORS:
+            return GLTF_SECTION_ACCESSORS;
+        case GLTF_ANIMATIONS:
+            return GLTF_SECTION_ANIMATIONS;
+        case GLTF_ASSET:
+            return GLTF_SECTION_ASSET;
+        case GLTF_BUFFERS:
+            return GLTF_SECTION_BUFFERS;
+        case GLTF_BUFFERVIEWS:
+            return GLTF_SECTION_BUFFERVIEWS;
+        case GLTF_CAMERAS:
+            return GLTF_SECTION_CAMERAS;
+        case GLTF_IMAGES:
+            return GLTF_SECTION_IMAGES;
+        case GLTF_MATERIALS:
+            return GLTF_SECTION_MATERIALS;
+        case GLTF_MESHES:
+            return GLTF_SECTION_MESHES;
+        case GLTF_NODES:
+            return GLTF_SECTION_NODES;
+        case GLTF_SAMPLERS:
+            return GLTF_SECTION_SAMPLERS;
+        case GLTF_SCENE:
+            return GLTF_SECTION_SCENE;
+        case GLTF_SCENES:
+            return GLTF_SECTION_SCENES;
+        case GLTF_SKINS:
+            return GLTF_SECTION_SKINS;
+        case GLTF_TEXTURES:
+            return GLTF_SECTION_TEXTURES;
+        case GLTF_EXTENSIONS:
+            return GLTF_SECTION_EXTENSIONS;
+        case GLTF_EXTRAS:
+            return GLTF_SECTION_EXTRAS;
+        default:
+            return 0;
+        }
+    }
+
     s32 glTFBase::getKeyCode(const String& key)
     {
-        u32 hash = hash_FNV1a(reinterpret_cast<const u8*>(key.c_str()), key.length());
-        for(s32 i=0; i<NumWords; ++i){
-            if(hash == words[i].hash_ && 0==strcmp(key.c_str(), words[i].str_)){
-                return i;
-            }
+        return getKeyCode(key.length(), key.c_str());
+    }
+
+    s32 glTFBase::getKeyCode(s32 length, const Char* key)
+    {
+        u32 hash = 2166136261U;
+        for(s32 i=0; i<length; ++i){
+            hash ^= static_cast<u8>(key[i]);
+            hash *= 16777619U;
         }
-        return -1;
+        const Word& word = words[keySlot(hash)];
+        if(word.length_ != length || 0 != ::memcmp(word.str_, key, length)){
+            return -1;
+        }
+        return word.code_;
     }
 
     //---------------------------------------------------------------
@@ -4566,6 +7697,8 @@ namespace
         extensions_.initialize();
         extras_.initialize();
         data_ = CPPGLTF_NULL;
+        source_ = CPPGLTF_NULL;
+        sourceLength_ = 0;
     }
 
     boolean Buffer::checkRequirements() const
@@ -4579,13 +7712,18 @@ namespace
 namespace
 {
     static const Char* Base64URL = "data:application/octet-stream;base64,";
-    FILE* open(const String& uri, const String& directory, const Char* mode)
+    static const s32 MaxPathBuffer = 128;
+    /// A data URI is a single JSON string with a 32 bit length, which leaves room for the header
+    static const s64 MaxDataURIBytes = (0x7FFFFFFF/4)*3 - 1024;
+
+    /**
+    @brief Concatenate directory and uri into buffer, or into an allocated one if it is too short
+    */
+    Char* getPath(Char (&buffer)[MaxPathBuffer], const String& uri, const String& directory)
     {
-        static const s32 MaxBuffer = 128;
         s32 length = uri.length() + directory.length();
-        Char buffer[MaxBuffer];
         Char* buff;
-        if(length<MaxBuffer){
+        if(length<MaxPathBuffer){
             buff = buffer;
         }else{
             buff = (Char*)CPPGLTF_MALLOC(sizeof(Char)*(length+1));
@@ -4593,185 +7731,570 @@ namespace
         ::memcpy(buff, directory.c_str(), directory.length());
         ::memcpy(buff+directory.length(), uri.c_str(), uri.length());
         buff[length] = '\0';
-        FILE* file = CPPGLTF_FOPEN(buff, mode);
-        if(buff != buffer){
-            CPPGLTF_FREE(buff);
-        }
-        return file;
+        return buff;
     }
-}
-    boolean load(Buffer& buffer, const String& directory)
+
+    FILE* open(const String& uri, const String& directory, const Char* mode)
     {
-        static const s32 l = static_cast<s32>(::strlen(Base64URL));
-        if(buffer.uri_.startWith(Base64URL)){
-            s32 dl = decodeBase64(buffer.data_, buffer.byteLength_, reinterpret_cast<const s8*>(buffer.uri_.c_str()+l));
-            return dl == buffer.byteLength_;
+        Char buffer[MaxPathBuffer];
+        Char* path = getPath(buffer, uri, directory);
+        FILE* file = CPPGLTF_FOPEN(path, mode);
+        if(path != buffer){
+            CPPGLTF_FREE(path);
         }
+        return file;
+    }
 
-        FILE* file = open(buffer.uri_, directory, "rb");
-        if(CPPGLTF_NULL == file){
+    /**
+    @brief Read size bytes at offset, with pread where available
+    */
+    boolean readAt(FILE* file, s64 offset, s64 size, u8* dst)
+    {
+#ifdef _MSC_VER
+        if(0 != CPPGLTF_FSEEK(file, offset, SEEK_SET)){
             return false;
         }
-        size_type ret = fread(buffer.data_, buffer.byteLength_, 1, file);
-        fclose(file);
-        return 0<ret;
+        return readChunked(file, dst, size);
+#else
+        s32 fd = fileno(file);
+        while(0<size){
+            ssize_t ret = ::pread(fd, dst, static_cast<size_type>(size<MaxIOChunk? size : MaxIOChunk), offset);
+            if(ret<=0){
+                return false;
+            }
+            dst += ret;
+            offset += ret;
+            size -= ret;
+        }
+        return true;
+#endif
     }
 
-    boolean save(String& uri, const Buffer& buffer, const String& directory)
+    struct ViewRange
     {
-        if(buffer.uri_.length()<=0){
-            return true;
-        }
+        s32 buffer_;
+        s32 bufferView_;
+        s64 begin_;
+        s64 end_;
+    };
 
-        static const s32 l = static_cast<s32>(::strlen(Base64URL));
-        if(buffer.uri_.startWith(Base64URL)){
-            s32 length = getLengthEncodedBase64(buffer.byteLength_);
-            s8* buff = (s8*)CPPGLTF_MALLOC(length+l+1);
-            ::memcpy(buff, buffer.uri_.c_str(), l);
-            encodeBase64(buff+l, length, buffer.data_);
-            length +=l;
-            buff[length] = '\0';
-            uri.assign(length, reinterpret_cast<const Char*>(buff));
-            CPPGLTF_FREE(buff);
-            return true;
+    int compareViewRange(const void* x0, const void* x1)
+    {
+        const ViewRange& r0 = *reinterpret_cast<const ViewRange*>(x0);
+        const ViewRange& r1 = *reinterpret_cast<const ViewRange*>(x1);
+        if(r0.buffer_ != r1.buffer_){
+            return r0.buffer_<r1.buffer_? -1 : 1;
         }
-
-        FILE* file = open(buffer.uri_, directory, "wb");
-        if(CPPGLTF_NULL == file){
-            return false;
+        if(r0.begin_ != r1.begin_){
+            return r0.begin_<r1.begin_? -1 : 1;
         }
-        size_type ret = fwrite(buffer.data_, buffer.byteLength_, 1, file);
-        fclose(file);
-        uri.assign(buffer.uri_.length(), buffer.uri_.c_str());
-        return 0<ret;
-    }
-
-    //---------------------------------------------------------------
-    void BufferView::initialize()
-    {
-        buffer_ = -1;
-        byteOffset_ = 0;
-        byteLength_ = -1;
-        byteStride_ = -1;
-        target_ = -1;
-        extensions_.initialize();
-        extras_.initialize();
+        return 0;
     }
 
-    boolean BufferView::checkRequirements() const
+    boolean map(u8*& data, s64& length, const Buffer& buffer, const String& directory)
     {
-        if(buffer_<0){
-            return false;
+        Char pathBuffer[MaxPathBuffer];
+        Char* path = getPath(pathBuffer, buffer.uri_, directory);
+        boolean result = mapFile(data, length, path);
+        if(path != pathBuffer){
+            CPPGLTF_FREE(path);
         }
-        if(byteLength_<0){
+        if(result && length<buffer.byteLength_){
+            unmapFile(data, length);
+            data = CPPGLTF_NULL;
+            length = 0;
             return false;
         }
-        return true;
+        return result;
     }
 
-    //---------------------------------------------------------------
-    void Orthographic::initialize()
+    /**
+    @return The value of an octal field in a tar header
+    */
+    s64 parseOctal(s32 length, const u8* field)
     {
-        xmag_ = 0.0f;
-        ymag_ = 0.0f;
-        zfar_ = 0.0f;
-        znear_ = 0.0f;
-        extensions_.initialize();
-        extras_.initialize();
+        s64 value = 0;
+        for(s32 i=0; i<length && '0'<=field[i] && field[i]<='7'; ++i){
+            value = (value<<3) + (field[i]-'0');
+        }
+        return value;
     }
 
-    boolean Orthographic::checkRequirements() const
+    const Char* skipCurrentDirectory(s32& length, const Char* name)
     {
-        if(xmag_<=0.0f){
-            return false;
+        while(2<=length && '.' == name[0] && '/' == name[1]){
+            name += 2;
+            length -= 2;
         }
-        if(ymag_<=0.0f){
-            return false;
-        }
-        if(zfar_<=znear_){
-            return false;
-        }
-        return true;
+        return name;
     }
+}
 
     //---------------------------------------------------------------
-    void Perspective::initialize()
+    StdioFileProvider& StdioFileProvider::getDefault()
     {
-        aspectRatio_ = 0.0f;
-        yfov_ = 0.0f;
-        zfar_ = 0.0f;
-        znear_ = 0.0f;
-        extensions_.initialize();
-        extras_.initialize();
+        static StdioFileProvider provider;
+        return provider;
     }
 
-    boolean Perspective::checkRequirements() const
+    FileProvider::Handle StdioFileProvider::open(const String& uri, const String& directory)
     {
-        if(aspectRatio_<=0.0f){
-            return false;
-        }
-        if(yfov_<=0.0f){
-            return false;
-        }
-        if(zfar_<=znear_){
-            return false;
-        }
-        return true;
+        return cppgltf::open(uri, directory, "rb");
     }
 
-    //---------------------------------------------------------------
-    void Camera::initialize()
+    void StdioFileProvider::close(Handle handle)
     {
-        orthographic_.initialize();
-        perspective_.initialize();
-        type_ = -1;
-        extensions_.initialize();
-        extras_.initialize();
+        FILE* file = reinterpret_cast<FILE*>(handle);
+        CPPGLTF_FCLOSE(file);
     }
 
-    boolean Camera::checkRequirements() const
+    s64 StdioFileProvider::size(Handle handle)
     {
-        switch(type_)
-        {
-        case GLTF_CAMERA_TYPE_PERSPECTIVE:
-            return perspective_.checkRequirements();
-        case GLTF_CAMERA_TYPE_ORTHOGRAPHIC:
-            return orthographic_.checkRequirements();
-        default:
-            return false;
-        }
+        return CPPGLTF_FSIZE(reinterpret_cast<FILE*>(handle));
     }
 
-    //---------------------------------------------------------------
-    void Image::initialize()
+    boolean StdioFileProvider::read(Handle handle, s64 offset, s64 size, u8* dst)
     {
-        bufferView_ = -1;
-        extensions_.initialize();
-        extras_.initialize();
+        return readAt(reinterpret_cast<FILE*>(handle), offset, size, dst);
     }
 
     //---------------------------------------------------------------
-    void TextureInfo::initialize()
+    PackFileProvider::PackFileProvider()
+        :file_(CPPGLTF_NULL)
+        ,fileSize_(0)
     {
-        index_ = -1;
-        texCoord_ = 0;
-        extensions_.initialize();
-        extras_.initialize();
     }
 
-    boolean TextureInfo::checkRequirements() const
+    PackFileProvider::~PackFileProvider()
     {
-        if(index_<0){
+        closePack();
+    }
+
+    bool PackFileProvider::openPack(const Char* filepath)
+    {
+        CPPGLTF_ASSERT(CPPGLTF_NULL != filepath);
+        closePack();
+        file_ = CPPGLTF_FOPEN(filepath, "rb");
+        if(CPPGLTF_NULL == file_){
             return false;
         }
+        fileSize_ = CPPGLTF_FSIZE(file_);
+        readTar();
         return true;
     }
 
-    //---------------------------------------------------------------
-    void NormalTextureInfo::initialize()
+    void PackFileProvider::closePack()
     {
-        index_ = -1;
-        texCoord_ = 0;
+        CPPGLTF_FCLOSE(file_);
+        fileSize_ = 0;
+        entries_.clear();
+        sorted_.clear();
+    }
+
+    void PackFileProvider::readTar()
+    {
+        static const s32 BlockSize = 512;
+        static const s32 NameOffset = 0;
+        static const s32 NameSize = 100;
+        static const s32 SizeOffset = 124;
+        static const s32 TypeOffset = 156;
+        static const s32 MagicOffset = 257;
+        static const s32 PrefixOffset = 345;
+        static const s32 PrefixSize = 155;
+
+        u8 header[BlockSize];
+        Char name[PrefixSize+1+NameSize+1];
+        String longName;
+        for(s64 offset = 0; offset+BlockSize<=fileSize_;){
+            if(!readAt(file_, offset, BlockSize, header)){
+                return;
+            }
+            //Ends with a zero block, and is not a tar archive without the magic of ustar or GNU
+            if('\0' == header[NameOffset] || 0 != ::memcmp(header+MagicOffset, "ustar", 5)){
+                return;
+            }
+            s64 size = parseOctal(12, header+SizeOffset);
+            offset += BlockSize;
+            //Truncated or broken
+            if(size<0 || fileSize_-offset<size){
+                return;
+            }
+            Char type = static_cast<Char>(header[TypeOffset]);
+            switch(type)
+            {
+            case '\0':
+            case '0':
+            case '7':
+                if(0<longName.length()){
+                    add(longName.c_str(), offset, size);
+                }else{
+                    s32 length = 0;
+                    const Char* prefix = reinterpret_cast<const Char*>(header+PrefixOffset);
+                    s32 prefixLength = static_cast<s32>(::strnlen(prefix, PrefixSize));
+                    if(0<prefixLength){
+                        ::memcpy(name, prefix, prefixLength);
+                        name[prefixLength] = '/';
+                        length = prefixLength+1;
+                    }
+                    const Char* str = reinterpret_cast<const Char*>(header+NameOffset);
+                    s32 nameLength = static_cast<s32>(::strnlen(str, NameSize));
+                    ::memcpy(name+length, str, nameLength);
+                    name[length+nameLength] = '\0';
+                    add(name, offset, size);
+                }
+                break;
+            case 'L':
+            {
+                //GNU long name in the data
+                Char* buffer = (Char*)CPPGLTF_MALLOC(static_cast<size_type>(size+1));
+                if(CPPGLTF_NULL != buffer && readAt(file_, offset, size, reinterpret_cast<u8*>(buffer))){
+                    buffer[size] = '\0';
+                    longName.assign(static_cast<s32>(::strlen(buffer)), buffer);
+                }
+                CPPGLTF_FREE(buffer);
+            }
+                break;
+            case 'x':
+            {
+                //pax records "length key=value\n", of which path replaces the name
+                Char* buffer = (Char*)CPPGLTF_MALLOC(static_cast<size_type>(size+1));
+                if(CPPGLTF_NULL != buffer && readAt(file_, offset, size, reinterpret_cast<u8*>(buffer))){
+                    buffer[size] = '\0';
+                    for(Char* record = buffer; record<buffer+size;){
+                        s64 length = ::strtol(record, CPPGLTF_NULL, 10);
+                        if(length<=0 || buffer+size<record+length){
+                            break;
+                        }
+                        //The value is followed by the newline at the end of the record
+                        Char* key = static_cast<Char*>(::memchr(record, ' ', static_cast<size_type>(length)));
+                        if(CPPGLTF_NULL != key && key+6<=record+length-1 && 0 == ::strncmp(key+1, "path=", 5)){
+                            const Char* value = key+6;
+                            longName.assign(static_cast<s32>(record+length-1-value), value);
+                        }
+                        record += length;
+                    }
+                }
+                CPPGLTF_FREE(buffer);
+            }
+                break;
+            default:
+                break;
+            }
+            //A long name belongs to the next entry only, even a directory or a link
+            if('L' != type && 'x' != type){
+                longName.clear();
+            }
+            offset += (size+BlockSize-1)/BlockSize*BlockSize;
+        }
+    }
+
+    void PackFileProvider::add(const Char* name, s64 offset, s64 size)
+    {
+        CPPGLTF_ASSERT(CPPGLTF_NULL != name);
+        s32 length = static_cast<s32>(::strlen(name));
+        name = skipCurrentDirectory(length, name);
+        //Grow geometrically, an archive can have thousands of entries
+        s32 capacity = 16;
+        while(capacity<=entries_.size()){
+            capacity <<= 1;
+        }
+        entries_.reserve(capacity);
+        sorted_.reserve(capacity);
+        entries_.resize(entries_.size()+1);
+        Entry& entry = entries_.back();
+        entry.name_.assign(length, name);
+        entry.offset_ = offset;
+        entry.size_ = size;
+
+        //Insert into the sorted indices, a later entry of the same name replaces the former
+        s32 index = entries_.size()-1;
+        s32 begin = 0;
+        s32 end = sorted_.size();
+        while(begin<end){
+            s32 middle = (begin+end)>>1;
+            s32 compare = ::strcmp(entries_[sorted_[middle]].name_.c_str(), entry.name_.c_str());
+            if(0 == compare){
+                sorted_[middle] = index;
+                return;
+            }
+            if(compare<0){
+                begin = middle+1;
+            }else{
+                end = middle;
+            }
+        }
+        sorted_.push_back(index);
+        for(s32 i=sorted_.size()-1; begin<i; --i){
+            sorted_[i] = sorted_[i-1];
+        }
+        sorted_[begin] = index;
+    }
+
+    s32 PackFileProvider::getNumEntries() const
+    {
+        return sorted_.size();
+    }
+
+    s32 PackFileProvider::find(s32 length, const Char* name) const
+    {
+        name = skipCurrentDirectory(length, name);
+        s32 begin = 0;
+        s32 end = sorted_.size();
+        while(begin<end){
+            s32 middle = (begin+end)>>1;
+            const String& entryName = entries_[sorted_[middle]].name_;
+            s32 compare = ::strncmp(entryName.c_str(), name, static_cast<size_type>(length));
+            if(0 == compare && entryName.length() != length){
+                compare = (length<entryName.length())? 1 : -1;
+            }
+            if(0 == compare){
+                return sorted_[middle];
+            }
+            if(compare<0){
+                begin = middle+1;
+            }else{
+                end = middle;
+            }
+        }
+        return -1;
+    }
+
+    FileProvider::Handle PackFileProvider::open(const String& uri, const String& directory)
+    {
+        if(CPPGLTF_NULL == file_){
+            return CPPGLTF_NULL;
+        }
+        Char buffer[MaxPathBuffer];
+        Char* path = getPath(buffer, uri, directory);
+        s32 index = find(uri.length()+directory.length(), path);
+        if(path != buffer){
+            CPPGLTF_FREE(path);
+        }
+        //Index+1, so that the first entry is not NULL
+        return (0<=index)? reinterpret_cast<Handle>(static_cast<intptr_t>(index)+1) : CPPGLTF_NULL;
+    }
+
+    void PackFileProvider::close(Handle /*handle*/)
+    {
+    }
+
+    s64 PackFileProvider::size(Handle handle)
+    {
+        s32 index = static_cast<s32>(reinterpret_cast<intptr_t>(handle)-1);
+        return (0<=index && index<entries_.size())? entries_[index].size_ : -1;
+    }
+
+    boolean PackFileProvider::read(Handle handle, s64 offset, s64 size, u8* dst)
+    {
+        s32 index = static_cast<s32>(reinterpret_cast<intptr_t>(handle)-1);
+        if(index<0 || entries_.size()<=index){
+            return false;
+        }
+        const Entry& entry = entries_[index];
+        if(offset<0 || size<0 || entry.size_<offset+size || fileSize_<entry.offset_+entry.size_){
+            return false;
+        }
+#ifdef _MSC_VER
+        //fseek and fread of the shared handle
+        std::lock_guard<std::mutex> lock(mutex_);
+#endif
+        return readAt(file_, entry.offset_+offset, size, dst);
+    }
+
+    //---------------------------------------------------------------
+    boolean load(Buffer& buffer, const String& directory)
+    {
+        return load(buffer, directory, StdioFileProvider::getDefault());
+    }
+
+    boolean load(Buffer& buffer, const String& directory, FileProvider& provider)
+    {
+        static const s32 l = static_cast<s32>(::strlen(Base64URL));
+        if(buffer.uri_.startWith(Base64URL)){
+            //The payload was decoded from a stream which is gone
+            if(MaxDataURIBytes<buffer.byteLength_ || buffer.sourceLength_<0){
+                return false;
+            }
+            s32 dl;
+            if(CPPGLTF_NULL != buffer.source_){
+                dl = decodeBase64(buffer.data_, static_cast<s32>(buffer.byteLength_), buffer.sourceLength_, reinterpret_cast<const s8*>(buffer.source_));
+            }else{
+                dl = decodeBase64(buffer.data_, static_cast<s32>(buffer.byteLength_), buffer.uri_.length()-l, reinterpret_cast<const s8*>(buffer.uri_.c_str()+l));
+            }
+            return dl == buffer.byteLength_;
+        }
+
+        FileProvider::Handle file = provider.open(buffer.uri_, directory);
+        if(CPPGLTF_NULL == file){
+            return false;
+        }
+        boolean ret = provider.read(file, 0, buffer.byteLength_, buffer.data_);
+        provider.close(file);
+        return ret;
+    }
+
+    boolean save(String& uri, const Buffer& buffer, const String& directory)
+    {
+        if(buffer.uri_.length()<=0){
+            return true;
+        }
+        //Not loaded, such as a buffer deferred by glTF::Flag_LazyBuffers
+        if(CPPGLTF_NULL == buffer.data_ && 0<buffer.byteLength_){
+            return false;
+        }
+
+        static const s32 l = static_cast<s32>(::strlen(Base64URL));
+        if(buffer.uri_.startWith(Base64URL)){
+            if(MaxDataURIBytes<buffer.byteLength_){
+                return false;
+            }
+            s32 length = getLengthEncodedBase64(static_cast<s32>(buffer.byteLength_));
+            s8* buff = (s8*)CPPGLTF_MALLOC(length+l+1);
+            ::memcpy(buff, buffer.uri_.c_str(), l);
+            encodeBase64(buff+l, length, buffer.data_);
+            length +=l;
+            buff[length] = '\0';
+            uri.assign(length, reinterpret_cast<const Char*>(buff));
+            CPPGLTF_FREE(buff);
+            return true;
+        }
+
+        FILE* file = open(buffer.uri_, directory, "wb");
+        if(CPPGLTF_NULL == file){
+            return false;
+        }
+        boolean ret = writeChunked(file, buffer.data_, buffer.byteLength_);
+        fclose(file);
+        uri.assign(buffer.uri_.length(), buffer.uri_.c_str());
+        return ret;
+    }
+
+    //---------------------------------------------------------------
+    void BufferView::initialize()
+    {
+        buffer_ = -1;
+        byteOffset_ = 0;
+        byteLength_ = -1;
+        byteStride_ = -1;
+        target_ = -1;
+        extensions_.initialize();
+        extras_.initialize();
+    }
+
+    boolean BufferView::checkRequirements() const
+    {
+        if(buffer_<0){
+            return false;
+        }
+        if(byteLength_<0){
+            return false;
+        }
+        return true;
+    }
+
+    //---------------------------------------------------------------
+    void Orthographic::initialize()
+    {
+        xmag_ = 0.0f;
+        ymag_ = 0.0f;
+        zfar_ = 0.0f;
+        znear_ = 0.0f;
+        extensions_.initialize();
+        extras_.initialize();
+    }
+
+    boolean Orthographic::checkRequirements() const
+    {
+        if(xmag_<=0.0f){
+            return false;
+        }
+        if(ymag_<=0.0f){
+            return false;
+        }
+        if(zfar_<=znear_){
+            return false;
+        }
+        return true;
+    }
+
+    //---------------------------------------------------------------
+    void Perspective::initialize()
+    {
+        aspectRatio_ = 0.0f;
+        yfov_ = 0.0f;
+        zfar_ = 0.0f;
+        znear_ = 0.0f;
+        extensions_.initialize();
+        extras_.initialize();
+    }
+
+    boolean Perspective::checkRequirements() const
+    {
+        if(aspectRatio_<=0.0f){
+            return false;
+        }
+        if(yfov_<=0.0f){
+            return false;
+        }
+        if(zfar_<=znear_){
+            return false;
+        }
+        return true;
+    }
+
+    //---------------------------------------------------------------
+    void Camera::initialize()
+    {
+        orthographic_.initialize();
+        perspective_.initialize();
+        type_ = -1;
+        extensions_.initialize();
+        extras_.initialize();
+    }
+
+    boolean Camera::checkRequirements() const
+    {
+        switch(type_)
+        {
+        case GLTF_CAMERA_TYPE_PERSPECTIVE:
+            return perspective_.checkRequirements();
+        case GLTF_CAMERA_TYPE_ORTHOGRAPHIC:
+            return orthographic_.checkRequirements();
+        default:
+            return false;
+        }
+    }
+
+    //---------------------------------------------------------------
+    void Image::initialize()
+    {
+        bufferView_ = -1;
+        extensions_.initialize();
+        extras_.initialize();
+    }
+
+    //---------------------------------------------------------------
+    void TextureInfo::initialize()
+    {
+        index_ = -1;
+        texCoord_ = 0;
+        extensions_.initialize();
+        extras_.initialize();
+    }
+
+    boolean TextureInfo::checkRequirements() const
+    {
+        if(index_<0){
+            return false;
+        }
+        return true;
+    }
+
+    //---------------------------------------------------------------
+    void NormalTextureInfo::initialize()
+    {
+        index_ = -1;
+        texCoord_ = 0;
         scale_ = 1.0f;
         extensions_.initialize();
         extras_.initialize();
@@ -4982,17 +8505,32 @@ namespace
         ,bin_(CPPGLTF_NULL)
         ,glbSize_(0)
         ,glbBin_(CPPGLTF_NULL)
+        ,glbReference_(false)
+        ,loadFlags_(0)
+        ,fileProvider_(CPPGLTF_NULL)
     {
     }
 
     glTF::~glTF()
     {
+        releaseBuffers();
         CPPGLTF_FREE(bin_);
-        CPPGLTF_FREE(glbBin_);
+        if(!glbReference_){
+            CPPGLTF_FREE(glbBin_);
+        }
     }
 
     void glTF::initialize()
     {
+        releaseBuffers();
+        //Drop the GLB binary and the file it may have referenced
+        if(!glbReference_){
+            CPPGLTF_FREE(glbBin_);
+        }
+        glbSize_ = 0;
+        glbBin_ = CPPGLTF_NULL;
+        glbReference_ = false;
+        storage_.close();
         extensionsUsed_.clear();
         extensionsRequired_.clear();
         accessors_.clear();
@@ -5030,33 +8568,296 @@ namespace
         }
     }
 
-    boolean glTF::loadBuffers()
+    boolean glTF::loadBuffers(ThreadPool* threadPool, u32 flags)
     {
+        releaseBuffers();
+        loadFlags_ = flags;
+        //External files get their own storage instead of a slice of bin_
+        boolean separate = 0 != (flags&(Flag_MapBuffers|Flag_LazyBuffers));
+        if(separate){
+            bufferStorages_.resize(buffers_.size());
+            for(s32 i=0; i<bufferStorages_.size(); ++i){
+                bufferStorages_[i].data_ = CPPGLTF_NULL;
+                bufferStorages_[i].length_ = 0;
+                bufferStorages_[i].mapped_ = false;
+            }
+        }
+
         //Buffers
-        u32 byteLength = 0;
+        s64 byteLength = 0;
+        s32 numLoads = 0;
         for(s32 i=0; i<buffers_.size(); ++i){
             if(buffers_[i].uri_.length()<=0){
                 continue;
             }
+            ++numLoads;
+            if(separate && !buffers_[i].uri_.startWith(Base64URL)){
+                continue;
+            }
             byteLength += buffers_[i].byteLength_;
         }
         allocate(byteLength);
+        //Each buffer gets its own slice, so the loads are independent
         byteLength = 0;
         for(s32 i=0; i<buffers_.size(); ++i){
-            if(0<buffers_[i].uri_.length()){
-                buffers_[i].data_ = bin_+byteLength;
-                if(!load(buffers_[i], directory_)){
+            if(buffers_[i].uri_.length()<=0){
+                continue;
+            }
+            if(separate && !buffers_[i].uri_.startWith(Base64URL)){
+                buffers_[i].data_ = CPPGLTF_NULL;
+                continue;
+            }
+            buffers_[i].data_ = bin_+byteLength;
+            byteLength += buffers_[i].byteLength_;
+        }
+        //One buffer at a time, each of which may use the pool itself
+        if(CPPGLTF_NULL == threadPool || numLoads<=1){
+            for(s32 i=0; i<buffers_.size(); ++i){
+                if(!loadBuffer(i, flags, threadPool)){
                     return false;
                 }
-                byteLength += buffers_[i].byteLength_;
             }
+            return true;
+        }
+
+        std::atomic<s32> failed(0);
+        threadPool->parallelFor(buffers_.size(), 1, [this, flags, &failed](s32 begin, s32 end){
+            for(s32 i=begin; i<end; ++i){
+                if(!loadBuffer(i, flags, CPPGLTF_NULL)){
+                    failed.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+        return 0 == failed.load();
+    }
+
+    boolean glTF::loadBuffer(s32 index, u32 flags, ThreadPool* threadPool)
+    {
+        Buffer& buffer = buffers_[index];
+        if(buffer.uri_.length()<=0){
+            return true;
+        }
+        if(buffer.uri_.startWith(Base64URL)){
+            if(CPPGLTF_NULL == threadPool || MaxDataURIBytes<buffer.byteLength_ || buffer.sourceLength_<0){
+                return load(buffer, directory_);
+            }
+            if(CPPGLTF_NULL != buffer.source_){
+                return decodeBuffer(buffer, buffer.sourceLength_, buffer.source_, *threadPool);
+            }
+            static const s32 l = static_cast<s32>(::strlen(Base64URL));
+            return decodeBuffer(buffer, buffer.uri_.length()-l, buffer.uri_.c_str()+l, *threadPool);
+        }
+        if(Flag_LazyBuffers == (flags&Flag_LazyBuffers)){
+            return true;
+        }
+        if(Flag_MapBuffers != (flags&Flag_MapBuffers)){
+            return load(buffer, directory_, getFileProvider());
+        }
+        return loadStorage(index, flags);
+    }
+
+    boolean glTF::loadStorage(s32 index, u32 flags)
+    {
+        Buffer& buffer = buffers_[index];
+        BufferStorage& storage = bufferStorages_[index];
+        //Only files in the file system can be mapped
+        if(Flag_MapBuffers == (flags&Flag_MapBuffers) && CPPGLTF_NULL == fileProvider_){
+            if(!map(storage.data_, storage.length_, buffer, directory_)){
+                return false;
+            }
+            storage.mapped_ = true;
+            buffer.data_ = storage.data_;
+            return true;
+        }
+        if(buffer.byteLength_<=0){
+            return true;
+        }
+        storage.data_ = (u8*)CPPGLTF_MALLOC(static_cast<size_type>(buffer.byteLength_));
+        storage.length_ = buffer.byteLength_;
+        storage.mapped_ = false;
+        buffer.data_ = storage.data_;
+        if(!load(buffer, directory_, getFileProvider())){
+            buffer.data_ = CPPGLTF_NULL;
+            CPPGLTF_FREE(storage.data_);
+            storage.data_ = CPPGLTF_NULL;
+            storage.length_ = 0;
+            return false;
         }
         return true;
     }
 
+    u8* glTF::getBufferData(s32 buffer)
+    {
+        CPPGLTF_ASSERT(0<=buffer && buffer<buffers_.size());
+        if(Flag_LazyBuffers != (loadFlags_&Flag_LazyBuffers) || bufferStorages_.size()<=buffer){
+            return buffers_[buffer].data_;
+        }
+        std::lock_guard<std::mutex> lock(bufferMutex_);
+        Buffer& target = buffers_[buffer];
+        if(CPPGLTF_NULL == target.data_ && 0<target.uri_.length() && !target.uri_.startWith(Base64URL)){
+            loadStorage(buffer, loadFlags_);
+        }
+        return target.data_;
+    }
+
+    boolean glTF::loadBufferViews(s32 numBufferViews, const s32* bufferViews)
+    {
+        CPPGLTF_ASSERT(0<=numBufferViews);
+        CPPGLTF_ASSERT(0 == numBufferViews || CPPGLTF_NULL != bufferViews);
+        std::lock_guard<std::mutex> lock(bufferMutex_);
+        if(viewData_.size()<bufferViews_.size()){
+            s32 size = viewData_.size();
+            viewData_.resize(bufferViews_.size());
+            for(s32 i=size; i<viewData_.size(); ++i){
+                viewData_[i] = CPPGLTF_NULL;
+            }
+        }
+
+        //Collect the ranges which are still in files
+        boolean result = true;
+        ViewRange* ranges = (ViewRange*)CPPGLTF_MALLOC(sizeof(ViewRange)*(numBufferViews+1));
+        s32 numRanges = 0;
+        for(s32 i=0; i<numBufferViews; ++i){
+            s32 index = bufferViews[i];
+            if(index<0 || bufferViews_.size()<=index){
+                result = false;
+                continue;
+            }
+            const BufferView& view = bufferViews_[index];
+            if(view.buffer_<0 || buffers_.size()<=view.buffer_){
+                result = false;
+                continue;
+            }
+            const Buffer& buffer = buffers_[view.buffer_];
+            if(CPPGLTF_NULL != viewData_[index] || CPPGLTF_NULL != buffer.data_
+                || buffer.uri_.length()<=0 || buffer.uri_.startWith(Base64URL)){
+                continue;
+            }
+            if(view.byteOffset_<0 || view.byteLength_<0 || buffer.byteLength_<view.byteOffset_+view.byteLength_){
+                result = false;
+                continue;
+            }
+            ranges[numRanges].buffer_ = view.buffer_;
+            ranges[numRanges].bufferView_ = index;
+            ranges[numRanges].begin_ = view.byteOffset_;
+            ranges[numRanges].end_ = view.byteOffset_ + view.byteLength_;
+            ++numRanges;
+        }
+        ::qsort(ranges, numRanges, sizeof(ViewRange), compareViewRange);
+
+        //Merge neighbors in each file, then read each merged range at once
+        FileProvider& provider = getFileProvider();
+        FileProvider::Handle file = CPPGLTF_NULL;
+        s32 fileBuffer = -1;
+        for(s32 i=0; i<numRanges;){
+            s32 buffer = ranges[i].buffer_;
+            s64 begin = ranges[i].begin_;
+            s64 end = ranges[i].end_;
+            s32 last = i+1;
+            for(; last<numRanges && ranges[last].buffer_ == buffer && ranges[last].begin_<=end+MaxReadGap; ++last){
+                end = (end<ranges[last].end_)? ranges[last].end_ : end;
+            }
+            if(fileBuffer != buffer){
+                if(CPPGLTF_NULL != file){
+                    provider.close(file);
+                }
+                file = provider.open(buffers_[buffer].uri_, directory_);
+                fileBuffer = buffer;
+            }
+            u8* block = (CPPGLTF_NULL != file)? (u8*)CPPGLTF_MALLOC(static_cast<size_type>(end-begin+1)) : CPPGLTF_NULL;
+            if(CPPGLTF_NULL != block && provider.read(file, begin, end-begin, block)){
+                viewBlocks_.push_back(block);
+                for(s32 j=i; j<last; ++j){
+                    viewData_[ranges[j].bufferView_] = block + (ranges[j].begin_-begin);
+                }
+            }else{
+                CPPGLTF_FREE(block);
+                result = false;
+            }
+            i = last;
+        }
+        if(CPPGLTF_NULL != file){
+            provider.close(file);
+        }
+        CPPGLTF_FREE(ranges);
+        return result;
+    }
+
+    u8* glTF::getBufferViewData(s32 bufferView)
+    {
+        CPPGLTF_ASSERT(0<=bufferView && bufferView<bufferViews_.size());
+        if(bufferView<viewData_.size() && CPPGLTF_NULL != viewData_[bufferView]){
+            return viewData_[bufferView];
+        }
+        const BufferView& view = bufferViews_[bufferView];
+        if(view.buffer_<0 || buffers_.size()<=view.buffer_){
+            return CPPGLTF_NULL;
+        }
+        u8* data = getBufferData(view.buffer_);
+        return (CPPGLTF_NULL != data)? data + view.byteOffset_ : CPPGLTF_NULL;
+    }
+
+    u8* glTF::getAccessorData(s32 accessor)
+    {
+        CPPGLTF_ASSERT(0<=accessor && accessor<accessors_.size());
+        const Accessor& target = accessors_[accessor];
+        if(target.bufferView_<0 || bufferViews_.size()<=target.bufferView_){
+            return CPPGLTF_NULL;
+        }
+        u8* data = getBufferViewData(target.bufferView_);
+        return (CPPGLTF_NULL != data)? data + target.byteOffset_ : CPPGLTF_NULL;
+    }
+
+    boolean glTF::decodeBuffer(Buffer& buffer, s32 length, const Char* src, ThreadPool& threadPool)
+    {
+        //Every 4 characters become 3 bytes, so each chunk has its own slice of the destination
+        s32 numChunks = (length + Base64ChunkSize - 1)/Base64ChunkSize;
+        std::atomic<s32> failed(0);
+        threadPool.parallelFor(numChunks, 1, [&buffer, length, src, numChunks, &failed](s32 begin, s32 end){
+            for(s32 i=begin; i<end; ++i){
+                s32 start = i*Base64ChunkSize;
+                s32 offset = (start>>2)*3;
+                s32 chars = (i+1 == numChunks)? length-start : Base64ChunkSize;
+                s32 size = static_cast<s32>(buffer.byteLength_-offset);
+                if(i+1 != numChunks && (Base64ChunkSize>>2)*3<size){
+                    size = (Base64ChunkSize>>2)*3;
+                }
+                if(size<=0){
+                    continue;
+                }
+                if(size != decodeBase64(buffer.data_+offset, size, chars, reinterpret_cast<const s8*>(src+start))){
+                    failed.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+        return 0 == failed.load() && (0<numChunks || buffer.byteLength_<=0);
+    }
+
+    void glTF::releaseBuffers()
+    {
+        for(s32 i=0; i<bufferStorages_.size(); ++i){
+            BufferStorage& storage = bufferStorages_[i];
+            if(i<buffers_.size() && buffers_[i].data_ == storage.data_){
+                buffers_[i].data_ = CPPGLTF_NULL;
+            }
+            if(storage.mapped_){
+                unmapFile(storage.data_, storage.length_);
+            }else{
+                CPPGLTF_FREE(storage.data_);
+            }
+        }
+        bufferStorages_.clear();
+        for(s32 i=0; i<viewBlocks_.size(); ++i){
+            CPPGLTF_FREE(viewBlocks_[i]);
+        }
+        viewBlocks_.clear();
+        viewData_.clear();
+        loadFlags_ = 0;
+    }
+
     boolean glTF::loadGLBBuffers()
     {
-        u32 glbOffset = 0;
+        s64 glbOffset = 0;
         for(s32 i=0; i<buffers_.size(); ++i){
             if(buffers_[i].uri_.length()<=0){
                 buffers_[i].data_ = getGLB(glbOffset);
@@ -5131,198 +8932,1365 @@ namespace
                 return false;
             }
         }
-        //for(s32 i=0; i<textures_.size(); ++i){
-        //    if(!textures_[i].checkRequirements()){
-        //        return false;
-        //    }
-        //}
-        return true;
+        //for(s32 i=0; i<textures_.size(); ++i){
+        //    if(!textures_[i].checkRequirements()){
+        //        return false;
+        //    }
+        //}
+        return true;
+    }
+
+    void glTF::allocate(s64 size)
+    {
+        CPPGLTF_FREE(bin_);
+        size_ = size;
+        bin_ = (u8*)CPPGLTF_MALLOC(static_cast<size_type>(size_));
+    }
+
+    s64 glTF::size() const
+    {
+        return size_;
+    }
+
+    const u8* glTF::getBin(s64 offset) const
+    {
+        CPPGLTF_ASSERT(offset<size_);
+        return bin_+offset;
+    }
+
+    u8* glTF::getBin(s64 offset)
+    {
+        CPPGLTF_ASSERT(offset<size_);
+        return bin_+offset;
+    }
+
+    void glTF::allocateGLB(s64 size)
+    {
+        if(!glbReference_){
+            CPPGLTF_FREE(glbBin_);
+        }
+        glbSize_ = size;
+        glbBin_ = (u8*)CPPGLTF_MALLOC(static_cast<size_type>(glbSize_));
+        glbReference_ = false;
+    }
+
+    void glTF::referenceGLB(s64 size, u8* data)
+    {
+        if(!glbReference_){
+            CPPGLTF_FREE(glbBin_);
+        }
+        glbSize_ = size;
+        glbBin_ = data;
+        glbReference_ = true;
+    }
+
+    s64 glTF::sizeGLB() const
+    {
+        return glbSize_;
+    }
+
+    const u8* glTF::getGLB(s64 offset) const
+    {
+        CPPGLTF_ASSERT(offset<glbSize_);
+        return glbBin_+offset;
+    }
+
+    u8* glTF::getGLB(s64 offset)
+    {
+        CPPGLTF_ASSERT(offset<glbSize_);
+        return glbBin_+offset;
+    }
+
+    void glTF::setFileProvider(FileProvider* provider)
+    {
+        releaseBuffers();
+        fileProvider_ = provider;
+    }
+
+    FileProvider& glTF::getFileProvider()
+    {
+        return (CPPGLTF_NULL != fileProvider_)? *fileProvider_ : StdioFileProvider::getDefault();
+    }
+
+    void glTF::holdStorage(IMMStream&& storage)
+    {
+        storage_ = std::move(storage);
+    }
+
+    void glTF::traverse(s32 rootScene, std::function<void(const Node&, const glTF&)>func) const
+    {
+        const Scene& scene = scenes_[rootScene];
+        for(s32 i = 0; i<scene.nodes_.size(); ++i){
+            traverseChildren(scene.nodes_[i], func);
+        }
+    }
+
+    void glTF::traverseChildren(s32 rootNode, std::function<void(const Node&, const glTF&)> func) const
+    {
+        //Go down to descendants
+        const Node& node = nodes_[rootNode];
+        func(node, *this);
+        for(s32 i = 0; i<node.children_.size(); ++i){
+            traverseChildren(node.children_[i], func);
+        }
+    }
+
+    void glTF::Counter::operator()(const Node& node, const glTF& gltf)
+    {
+        numNodes_ += node.children_.size();
+
+        if(0<=node.camera_){
+            ++numCameras_;
+        }
+        if(0<=node.skin_){
+            ++numSkins_;
+        }
+        if(0<=node.mesh_){
+            ++numMeshes_;
+
+            const Mesh& mesh = gltf.meshes_[node.mesh_];
+            numPrimitives_ += mesh.primitives_.size();
+
+            //Count textures
+            for(s32 i = 0; i<mesh.primitives_.size(); ++i){
+                const Primitive& primitive = mesh.primitives_[i];
+                if(primitive.material_<0){
+                    continue;
+                }
+                ++numMaterials_;
+                const Material& material = gltf.materials_[primitive.material_];
+                if(0 <= material.pbrMetallicRoughness_.baseColorTexture_.index_) {
+                    ++numTextures_;
+                }
+                if(0 <= material.pbrMetallicRoughness_.baseColorTexture_.index_) {
+                    ++numTextures_;
+                }
+                if(0 <= material.pbrMetallicRoughness_.metallicRoughnessTexture_.index_) {
+                    ++numTextures_;
+                }
+                if(0 <= material.normalTexture_.index_) {
+                    ++numTextures_;
+                }
+                if(0 <= material.occlusionTexture_.index_) {
+                    ++numTextures_;
+                }
+                if(0 <= material.emissiveTexture_.index_) {
+                    ++numTextures_;
+                }
+            }//for(s32 i
+        }//if(0<=node.mesh_)
+    }
+
+    void glTF::getSortedNodes(SortNode* nodes) const
+    {
+        //add root nodes
+        s32 rootCount=0;
+        for(s32 i=0; i<nodes_.size(); ++i){
+            if(isRoot(i, nodes_)){
+                nodes[rootCount].oldId_ = i;
+                nodes[rootCount].parent_ = -1;
+                nodes[rootCount].numChildren_ = 0;
+                nodes[rootCount].childrenStart_ = -1;
+                ++rootCount;
+            }
+        }
+
+        //By the glTF specification, a node hierarchy must be a strict tree.
+        //So this algorithm works, and will end sometime.
+        s32 count = rootCount;
+        for(s32 i=0; i<rootCount; ++i){
+            count = addChildren(i, count, nodes, nodes_);
+        }
+    }
+
+    boolean glTF::isRoot(s32 node, const Array<Node>& nodes)
+    {
+        for(s32 i=0; i<nodes.size(); ++i){
+            for(s32 j=0; j<nodes[i].children_.size(); ++j){
+                if(node == nodes[i].children_[j]){
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    s32 glTF::addChildren(s32 parent, s32 dstSize, SortNode* dst, const Array<Node>& nodes)
+    {
+        const Node& parentNode = nodes[dst[parent].oldId_];
+        dst[parent].childrenStart_ = dstSize;
+        dst[parent].numChildren_ = parentNode.children_.size();
+        //add children
+        for(s32 i=0; i<parentNode.children_.size(); ++i){
+            SortNode& n = dst[dstSize];
+            n.oldId_ = parentNode.children_[i];
+            n.parent_ = parent;
+            n.numChildren_ = nodes[n.oldId_].children_.size();
+            n.childrenStart_ = -1;
+            ++dstSize;
+        }
+        return dstSize;
+    }
+
+    //---------------------------------------------------------------
+    //---
+    //--- AccessorView
+    //---
+    //---------------------------------------------------------------
+    s32 getComponentSize(s32 componentType)
+    {
+        switch(componentType){
+        case GLTF_TYPE_BYTE:
+        case GLTF_TYPE_UNSIGNED_BYTE:
+            return 1;
+        case GLTF_TYPE_SHORT:
+        case GLTF_TYPE_UNSIGNED_SHORT:
+            return 2;
+        case GLTF_TYPE_INT:
+        case GLTF_TYPE_UNSIGNED_INT:
+        case GLTF_TYPE_FLOAT:
+            return 4;
+        default:
+            return 0;
+        }
+    }
+
+    s32 getNumComponents(s32 type)
+    {
+        switch(type){
+        case GLTF_TYPE_SCALAR:
+            return 1;
+        case GLTF_TYPE_VEC2:
+            return 2;
+        case GLTF_TYPE_VEC3:
+            return 3;
+        case GLTF_TYPE_VEC4:
+        case GLTF_TYPE_MAT2:
+            return 4;
+        case GLTF_TYPE_MAT3:
+            return 9;
+        case GLTF_TYPE_MAT4:
+            return 16;
+        default:
+            return 0;
+        }
+    }
+
+    s32 getElementSize(s32 componentType, s32 type)
+    {
+        s32 size = getComponentSize(componentType);
+        switch(type){
+        case GLTF_TYPE_MAT2:
+            return 2*((2*size+3)&~3);
+        case GLTF_TYPE_MAT3:
+            return 3*((3*size+3)&~3);
+        default:
+            return getNumComponents(type)*size;
+        }
+    }
+
+    u8* getAccessorElements(s32& stride, glTF& gltf, s32 accessor)
+    {
+        stride = 0;
+        if(accessor<0 || gltf.accessors_.size()<=accessor){
+            return CPPGLTF_NULL;
+        }
+        const Accessor& target = gltf.accessors_[accessor];
+        s32 elementSize = getElementSize(target.componentType_, target.type_);
+        if(elementSize<=0 || target.bufferView_<0 || gltf.bufferViews_.size()<=target.bufferView_ || target.count_<0 || target.byteOffset_<0){
+            return CPPGLTF_NULL;
+        }
+        const BufferView& view = gltf.bufferViews_[target.bufferView_];
+        s32 elementStride = (0<view.byteStride_)? view.byteStride_ : elementSize;
+        if(elementStride<elementSize){
+            return CPPGLTF_NULL;
+        }
+        if(0<target.count_ && view.byteLength_<target.byteOffset_ + static_cast<s64>(elementStride)*(target.count_-1) + elementSize){
+            return CPPGLTF_NULL;
+        }
+        u8* data = gltf.getAccessorData(accessor);
+        if(CPPGLTF_NULL != data){
+            stride = elementStride;
+        }
+        return data;
+    }
+
+namespace
+{
+    /**
+    @return true if the elements of an accessor can be converted as numComponents scalars without padding
+    */
+    boolean isConvertible(const Accessor& accessor)
+    {
+        if(GLTF_TYPE_FLOAT != accessor.componentType_ && !accessor.normalized_){
+            return false;
+        }
+        s32 size = getComponentSize(accessor.componentType_);
+        return 0<size && getElementSize(accessor.componentType_, accessor.type_) == size*getNumComponents(accessor.type_);
+    }
+}
+
+    boolean dequantize(f32* dst, glTF& gltf, s32 accessor)
+    {
+        CPPGLTF_ASSERT(CPPGLTF_NULL != dst);
+        if(accessor<0 || gltf.accessors_.size()<=accessor || !isConvertible(gltf.accessors_[accessor]) || gltf.accessors_[accessor].count_<0){
+            return false;
+        }
+        const Accessor& target = gltf.accessors_[accessor];
+        s32 numComponents = getNumComponents(target.type_);
+        //The sparse substitutions, or the zeros without a bufferView, are resolved first
+        u8* owned = CPPGLTF_NULL;
+        s32 stride;
+        const u8* data;
+        if(target.bufferView_<0 || 0<target.sparse_.count_){
+            stride = getElementSize(target.componentType_, target.type_);
+            owned = reinterpret_cast<u8*>(CPPGLTF_MALLOC(static_cast<size_t>(target.count_)*stride + 1));
+            data = (CPPGLTF_NULL != owned && materialize(owned, gltf, accessor))? owned : CPPGLTF_NULL;
+        }else{
+            data = getAccessorElements(stride, gltf, accessor);
+        }
+        boolean result = CPPGLTF_NULL != data;
+        if(result){
+            if(GLTF_TYPE_FLOAT == target.componentType_){
+                copyElements(reinterpret_cast<u8*>(dst), numComponents*sizeof(f32), data, stride, target.count_, numComponents*sizeof(f32));
+            }else{
+                result = toFloat(dst, target.componentType_, numComponents, target.count_, stride, data);
+            }
+        }
+        CPPGLTF_FREE(owned);
+        return result;
+    }
+
+    boolean quantize(glTF& gltf, s32 accessor, const f32* src)
+    {
+        CPPGLTF_ASSERT(CPPGLTF_NULL != src);
+        s32 stride;
+        u8* data = getAccessorElements(stride, gltf, accessor);
+        if(CPPGLTF_NULL == data || !isConvertible(gltf.accessors_[accessor]) || 0<gltf.accessors_[accessor].sparse_.count_){
+            return false;
+        }
+        const Accessor& target = gltf.accessors_[accessor];
+        s32 numComponents = getNumComponents(target.type_);
+        if(GLTF_TYPE_FLOAT == target.componentType_){
+            copyElements(data, stride, reinterpret_cast<const u8*>(src), numComponents*sizeof(f32), target.count_, numComponents*sizeof(f32));
+            return true;
+        }
+        return fromFloat(data, target.componentType_, numComponents, target.count_, stride, src);
+    }
+
+namespace
+{
+    template<class T> struct IndexTraits;
+    template<> struct IndexTraits<u8>
+    {
+#ifdef CPPGLTF_SSE2
+        static inline __m128i bias(){ return _mm_set1_epi8(-128);}
+        static inline __m128i set1(u32 x){ return _mm_set1_epi8(static_cast<s8>(x));}
+        static inline __m128i greater(__m128i x0, __m128i x1){ return _mm_cmpgt_epi8(x0, x1);}
+#endif
+    };
+    template<> struct IndexTraits<u16>
+    {
+#ifdef CPPGLTF_SSE2
+        static inline __m128i bias(){ return _mm_set1_epi16(-32768);}
+        static inline __m128i set1(u32 x){ return _mm_set1_epi16(static_cast<s16>(x));}
+        static inline __m128i greater(__m128i x0, __m128i x1){ return _mm_cmpgt_epi16(x0, x1);}
+#endif
+    };
+    template<> struct IndexTraits<u32>
+    {
+#ifdef CPPGLTF_SSE2
+        static inline __m128i bias(){ return _mm_set1_epi32(static_cast<s32>(0x80000000U));}
+        static inline __m128i set1(u32 x){ return _mm_set1_epi32(static_cast<s32>(x));}
+        static inline __m128i greater(__m128i x0, __m128i x1){ return _mm_cmpgt_epi32(x0, x1);}
+#endif
+    };
+
+    /**
+    @return true if all of indices are less than limit
+    */
+    template<class T>
+    boolean checkIndices(const T* indices, s32 count, u32 limit)
+    {
+        if(0 == limit){
+            return count<=0;
+        }
+        u32 last = limit-1;
+        if(static_cast<T>(-1)<=last){
+            return true;
+        }
+        s32 i = 0;
+#ifdef CPPGLTF_SSE2
+        {
+            //Compare as signed after flipping the sign bits, SSE2 has no unsigned comparison
+            static const s32 Lanes = 16/sizeof(T);
+            const __m128i bias = IndexTraits<T>::bias();
+            const __m128i bound = _mm_xor_si128(IndexTraits<T>::set1(last), bias);
+            __m128i over = _mm_setzero_si128();
+            for(; i+Lanes<=count; i+=Lanes){
+                __m128i x = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(indices+i)), bias);
+                over = _mm_or_si128(over, IndexTraits<T>::greater(x, bound));
+            }
+            if(0 != _mm_movemask_epi8(over)){
+                return false;
+            }
+        }
+#endif
+        for(; i<count; ++i){
+            if(last<indices[i]){
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template<s32 N, class T>
+    inline void scatterElements(u8* dst, const T* indices, const u8* values, s32 count)
+    {
+        for(s32 i=0; i<count; ++i){
+            ::memcpy(dst + static_cast<s64>(indices[i])*N, values, N);
+            values += N;
+        }
+    }
+
+    /**
+    @brief Copy tightly packed values to the elements at indices, with fixed sizes for common elements
+    */
+    template<class T>
+    void scatterElements(u8* dst, s32 size, const T* indices, const u8* values, s32 count)
+    {
+        switch(size){
+        case 1: scatterElements<1>(dst, indices, values, count); break;
+        case 2: scatterElements<2>(dst, indices, values, count); break;
+        case 3: scatterElements<3>(dst, indices, values, count); break;
+        case 4: scatterElements<4>(dst, indices, values, count); break;
+        case 6: scatterElements<6>(dst, indices, values, count); break;
+        case 8: scatterElements<8>(dst, indices, values, count); break;
+        case 12: scatterElements<12>(dst, indices, values, count); break;
+        case 16: scatterElements<16>(dst, indices, values, count); break;
+        default:
+            for(s32 i=0; i<count; ++i){
+                ::memcpy(dst + static_cast<s64>(indices[i])*size, values, size);
+                values += size;
+            }
+            break;
+        }
+    }
+
+    template<class T>
+    boolean scatterElements(u8* dst, s32 size, s32 limit, const u8* indices, const u8* values, s32 count)
+    {
+        const T* typed = reinterpret_cast<const T*>(indices);
+        if(!checkIndices(typed, count, static_cast<u32>(limit))){
+            return false;
+        }
+        scatterElements(dst, size, typed, values, count);
+        return true;
+    }
+
+    /**
+    @return Data of count elements of size in a bufferView, NULL if they are not available or short
+    */
+    const u8* getSparseData(glTF& gltf, s32 bufferView, s64 byteOffset, s32 count, s32 size)
+    {
+        if(bufferView<0 || gltf.bufferViews_.size()<=bufferView || byteOffset<0){
+            return CPPGLTF_NULL;
+        }
+        if(gltf.bufferViews_[bufferView].byteLength_<byteOffset + static_cast<s64>(count)*size){
+            return CPPGLTF_NULL;
+        }
+        const u8* data = gltf.getBufferViewData(bufferView);
+        return (CPPGLTF_NULL != data)? data + byteOffset : CPPGLTF_NULL;
+    }
+}
+
+    boolean materialize(u8* dst, glTF& gltf, s32 accessor)
+    {
+        if(accessor<0 || gltf.accessors_.size()<=accessor){
+            return false;
+        }
+        const Accessor& target = gltf.accessors_[accessor];
+        s32 elementSize = getElementSize(target.componentType_, target.type_);
+        if(elementSize<=0 || target.count_<0){
+            return false;
+        }
+        CPPGLTF_ASSERT(0==target.count_ || CPPGLTF_NULL != dst);
+        if(0<=target.bufferView_){
+            s32 stride;
+            const u8* data = getAccessorElements(stride, gltf, accessor);
+            if(CPPGLTF_NULL == data){
+                return false;
+            }
+            copyElements(dst, elementSize, data, stride, target.count_, elementSize);
+        }else{
+            ::memset(dst, 0, static_cast<size_t>(target.count_)*elementSize);
+        }
+
+        const Sparse& sparse = target.sparse_;
+        if(sparse.count_<=0){
+            return true;
+        }
+        //Both bufferViews are required, getSparseData fails without either
+        s32 indexSize = getComponentSize(sparse.indices_.componentType_);
+        const u8* indices = getSparseData(gltf, sparse.indices_.bufferView_, sparse.indices_.byteOffset_, sparse.count_, indexSize);
+        const u8* values = getSparseData(gltf, sparse.values_.bufferView_, sparse.values_.byteOffset_, sparse.count_, elementSize);
+        if(CPPGLTF_NULL == indices || CPPGLTF_NULL == values){
+            return false;
+        }
+        switch(sparse.indices_.componentType_){
+        case GLTF_TYPE_UNSIGNED_BYTE:
+            return scatterElements<u8>(dst, elementSize, target.count_, indices, values, sparse.count_);
+        case GLTF_TYPE_UNSIGNED_SHORT:
+            return scatterElements<u16>(dst, elementSize, target.count_, indices, values, sparse.count_);
+        case GLTF_TYPE_UNSIGNED_INT:
+            return scatterElements<u32>(dst, elementSize, target.count_, indices, values, sparse.count_);
+        default:
+            return false;
+        }
+    }
+
+    //---------------------------------------------------------------
+    //---
+    //--- ThreadPool
+    //---
+    //---------------------------------------------------------------
+    ThreadPool::ThreadPool()
+        :numThreads_(0)
+        ,threads_(CPPGLTF_NULL)
+        ,generation_(0)
+        ,stop_(false)
+        ,running_(0)
+        ,function_(CPPGLTF_NULL)
+        ,count_(0)
+        ,chunkSize_(1)
+        ,next_(0)
+    {
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        stop();
+    }
+
+    void ThreadPool::start(s32 numThreads)
+    {
+        stop();
+        if(numThreads<=0){
+            numThreads = static_cast<s32>(std::thread::hardware_concurrency())-1;
+        }
+        if(numThreads<=0){
+            return;
+        }
+        stop_ = false;
+        //Workers start from generation 0, so one left by a previous start must not wake them
+        generation_ = 0;
+        threads_ = (std::thread*)CPPGLTF_MALLOC(sizeof(std::thread)*numThreads);
+        for(s32 i=0; i<numThreads; ++i){
+            CPPGLTF_PLACEMENT_NEW(&threads_[i]) std::thread(&ThreadPool::run, this);
+        }
+        numThreads_ = numThreads;
+    }
+
+    void ThreadPool::stop()
+    {
+        if(CPPGLTF_NULL == threads_){
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for(s32 i=0; i<numThreads_; ++i){
+            threads_[i].join();
+            threads_[i].~thread();
+        }
+        CPPGLTF_FREE(threads_);
+        threads_ = CPPGLTF_NULL;
+        numThreads_ = 0;
+    }
+
+    void ThreadPool::parallelFor(s32 count, s32 chunkSize, const Function& func)
+    {
+        if(count<=0){
+            return;
+        }
+        if(numThreads_<=0 || count<=chunkSize){
+            func(0, count);
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            function_ = &func;
+            count_ = count;
+            chunkSize_ = (0<chunkSize)? chunkSize : 1;
+            next_.store(0);
+            running_ = numThreads_;
+            ++generation_;
+        }
+        wake_.notify_all();
+        work();
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this]{ return running_<=0;});
+        function_ = CPPGLTF_NULL;
+    }
+
+    void ThreadPool::run()
+    {
+        u32 generation = 0;
+        for(;;){
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_.wait(lock, [this, generation]{ return stop_ || generation != generation_;});
+                if(stop_){
+                    return;
+                }
+                generation = generation_;
+            }
+            work();
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if(--running_<=0){
+                    done_.notify_one();
+                }
+            }
+        }
+    }
+
+    void ThreadPool::work()
+    {
+        for(;;){
+            s32 begin = next_.fetch_add(chunkSize_);
+            if(count_<=begin){
+                break;
+            }
+            s32 end = (count_-begin<chunkSize_)? count_ : begin+chunkSize_;
+            (*function_)(begin, end);
+        }
+    }
+
+    //---------------------------------------------------------------
+    //---
+    //--- VertexLayout
+    //---
+    //---------------------------------------------------------------
+    void VertexElement::initialize()
+    {
+        semanticType_ = GLTF_ATTRIBUTE_POSITION;
+        semanticIndex_ = 0;
+        stream_ = 0;
+        offset_ = 0;
+        componentType_ = GLTF_TYPE_FLOAT;
+        numComponents_ = 3;
+        normalized_ = false;
+    }
+
+    VertexLayout::VertexLayout()
+    {
+        clear();
+    }
+
+    VertexLayout::~VertexLayout()
+    {
+    }
+
+    void VertexLayout::clear()
+    {
+        elements_.clear();
+        for(s32 i=0; i<MaxStreams; ++i){
+            strides_[i] = 0;
+        }
+    }
+
+    boolean VertexLayout::add(s32 semanticType, s32 semanticIndex, s32 componentType, s32 numComponents, boolean normalized, s32 stream)
+    {
+        if(stream<0 || MaxStreams<=stream){
+            return false;
+        }
+        VertexElement element;
+        element.semanticType_ = static_cast<s8>(semanticType);
+        element.semanticIndex_ = static_cast<s8>(semanticIndex);
+        element.stream_ = static_cast<s16>(stream);
+        element.offset_ = strides_[stream];
+        element.componentType_ = componentType;
+        element.numComponents_ = numComponents;
+        element.normalized_ = normalized;
+        return add(element);
+    }
+
+    boolean VertexLayout::add(const VertexElement& element)
+    {
+        s32 size = getComponentSize(element.componentType_);
+        if(element.stream_<0 || MaxStreams<=element.stream_ || element.offset_<0 || size<=0 || element.numComponents_<1 || 4<element.numComponents_){
+            return false;
+        }
+        s32 end = (element.offset_ + size*element.numComponents_ + 3) & ~3;
+        strides_[element.stream_] = (strides_[element.stream_]<end)? end : strides_[element.stream_];
+        elements_.push_back(element);
+        return true;
+    }
+
+namespace
+{
+    /// Vertices converted at once, and split on threads
+    static const s32 InterleaveBlockSize = 256;
+
+    class VertexSource
+    {
+    public:
+        const u8* data_;
+        u8* owned_;
+        s32 stride_;
+        s32 componentType_;
+        s32 numComponents_;
+        boolean normalized_;
+    };
+
+    s32 findAttribute(const Primitive& primitive, s32 semanticType, s32 semanticIndex)
+    {
+        for(s32 i=0; i<primitive.attributes_.size(); ++i){
+            const Attribute& attribute = primitive.attributes_[i];
+            if(semanticType == attribute.semanticType_ && semanticIndex == attribute.semanticIndex_){
+                return attribute.accessor_;
+            }
+        }
+        return -1;
+    }
+
+    boolean resolveSource(VertexSource& source, glTF& gltf, s32 accessor, s32 numVertices)
+    {
+        if(accessor<0 || gltf.accessors_.size()<=accessor){
+            return false;
+        }
+        const Accessor& target = gltf.accessors_[accessor];
+        source.componentType_ = target.componentType_;
+        source.numComponents_ = getNumComponents(target.type_);
+        source.normalized_ = target.normalized_;
+        s32 elementSize = getElementSize(target.componentType_, target.type_);
+        //Not matrices, even MAT2 of 4 components has the columns padded for bytes and shorts
+        if(target.type_<GLTF_TYPE_SCALAR || GLTF_TYPE_VEC4<target.type_ || elementSize<=0 || target.count_<numVertices){
+            return false;
+        }
+        if(target.bufferView_<0 || 0<target.sparse_.count_){
+            source.owned_ = reinterpret_cast<u8*>(CPPGLTF_MALLOC(static_cast<size_t>(target.count_)*elementSize + 1));
+            if(CPPGLTF_NULL == source.owned_ || !materialize(source.owned_, gltf, accessor)){
+                return false;
+            }
+            source.data_ = source.owned_;
+            source.stride_ = elementSize;
+            return true;
+        }
+        source.data_ = getAccessorElements(source.stride_, gltf, accessor);
+        return CPPGLTF_NULL != source.data_;
+    }
+
+    template<class T>
+    void castToFloat(f32* dst, s32 numComponents, s32 count, s32 srcStride, const u8* src)
+    {
+        for(s32 i=0; i<count; ++i){
+            for(s32 j=0; j<numComponents; ++j){
+                T x;
+                ::memcpy(&x, src + j*sizeof(T), sizeof(T));
+                dst[j] = static_cast<f32>(x);
+            }
+            dst += numComponents;
+            src += srcStride;
+        }
+    }
+
+    template<class T>
+    void castFromFloat(u8* dst, s32 numComponents, s32 count, s32 dstStride, const f32* src, f32 lower, f32 upper)
+    {
+        for(s32 i=0; i<count; ++i){
+            for(s32 j=0; j<numComponents; ++j){
+                f32 x = src[j];
+                x = (x<lower)? lower : x;
+                x = (upper<x)? upper : x;
+                T y = static_cast<T>(x);
+                ::memcpy(dst + j*sizeof(T), &y, sizeof(T));
+            }
+            dst += dstStride;
+            src += numComponents;
+        }
+    }
+
+    /**
+    @brief Read count elements from src into tightly packed floats
+    */
+    void readFloats(f32* dst, const VertexSource& source, s32 count, const u8* src)
+    {
+        s32 numComponents = source.numComponents_;
+        if(source.normalized_ && toFloat(dst, source.componentType_, numComponents, count, source.stride_, src)){
+            return;
+        }
+        switch(source.componentType_){
+        case GLTF_TYPE_BYTE:
+            castToFloat<s8>(dst, numComponents, count, source.stride_, src);
+            break;
+        case GLTF_TYPE_UNSIGNED_BYTE:
+            castToFloat<u8>(dst, numComponents, count, source.stride_, src);
+            break;
+        case GLTF_TYPE_SHORT:
+            castToFloat<s16>(dst, numComponents, count, source.stride_, src);
+            break;
+        case GLTF_TYPE_UNSIGNED_SHORT:
+            castToFloat<u16>(dst, numComponents, count, source.stride_, src);
+            break;
+        case GLTF_TYPE_UNSIGNED_INT:
+            castToFloat<u32>(dst, numComponents, count, source.stride_, src);
+            break;
+        default:
+            copyElements(reinterpret_cast<u8*>(dst), numComponents*sizeof(f32), src, source.stride_, count, numComponents*sizeof(f32));
+            break;
+        }
+    }
+
+    /**
+    @brief Write count elements from tightly packed floats into dst
+    */
+    void writeFloats(u8* dst, s32 dstStride, const VertexElement& element, s32 count, const f32* src)
+    {
+        s32 numComponents = element.numComponents_;
+        if(element.normalized_ && fromFloat(dst, element.componentType_, numComponents, count, dstStride, src)){
+            return;
+        }
+        switch(element.componentType_){
+        case GLTF_TYPE_BYTE:
+            castFromFloat<s8>(dst, numComponents, count, dstStride, src, -128.0f, 127.0f);
+            break;
+        case GLTF_TYPE_UNSIGNED_BYTE:
+            castFromFloat<u8>(dst, numComponents, count, dstStride, src, 0.0f, 255.0f);
+            break;
+        case GLTF_TYPE_SHORT:
+            castFromFloat<s16>(dst, numComponents, count, dstStride, src, -32768.0f, 32767.0f);
+            break;
+        case GLTF_TYPE_UNSIGNED_SHORT:
+            castFromFloat<u16>(dst, numComponents, count, dstStride, src, 0.0f, 65535.0f);
+            break;
+        case GLTF_TYPE_UNSIGNED_INT:
+            //The largest float under 2^32
+            castFromFloat<u32>(dst, numComponents, count, dstStride, src, 0.0f, 4294967040.0f);
+            break;
+        default:
+            copyElements(dst, dstStride, reinterpret_cast<const u8*>(src), numComponents*sizeof(f32), count, numComponents*sizeof(f32));
+            break;
+        }
+    }
+
+    void convertVertices(u8* dst, s32 dstStride, const VertexElement& element, const VertexSource& source, s32 first, s32 count)
+    {
+        static const u8 Zeros[16] = {0};
+        s32 size = getComponentSize(element.componentType_)*element.numComponents_;
+        if(CPPGLTF_NULL == source.data_){
+            copyElements(dst, dstStride, Zeros, 0, count, size);
+            return;
+        }
+        const u8* src = source.data_ + static_cast<s64>(source.stride_)*first;
+        boolean sameFormat = element.componentType_ == source.componentType_
+            && (GLTF_TYPE_FLOAT == element.componentType_ || element.normalized_ == source.normalized_);
+        if(sameFormat && element.numComponents_ == source.numComponents_){
+            copyElements(dst, dstStride, src, source.stride_, count, size);
+            return;
+        }
+
+        f32 values[InterleaveBlockSize*4];
+        readFloats(values, source, count, src);
+        if(element.numComponents_ != source.numComponents_){
+            //Move in place, forward when shrinking and backward when growing
+            s32 numSrc = source.numComponents_;
+            s32 numDst = element.numComponents_;
+            if(numDst<numSrc){
+                for(s32 i=0; i<count; ++i){
+                    for(s32 j=0; j<numDst; ++j){
+                        values[i*numDst+j] = values[i*numSrc+j];
+                    }
+                }
+            }else{
+                for(s32 i=count-1; 0<=i; --i){
+                    for(s32 j=numDst-1; 0<=j; --j){
+                        values[i*numDst+j] = (j<numSrc)? values[i*numSrc+j] : ((3==j)? 1.0f : 0.0f);
+                    }
+                }
+            }
+        }
+        writeFloats(dst, dstStride, element, count, values);
+    }
+}
+
+    s32 getNumVertices(glTF& gltf, const Primitive& primitive)
+    {
+        if(primitive.attributes_.size()<=0){
+            return -1;
+        }
+        s32 accessor = findAttribute(primitive, GLTF_ATTRIBUTE_POSITION, 0);
+        accessor = (accessor<0)? primitive.attributes_[0].accessor_ : accessor;
+        if(accessor<0 || gltf.accessors_.size()<=accessor){
+            return -1;
+        }
+        return gltf.accessors_[accessor].count_;
+    }
+
+    boolean interleave(u8* const* streams, glTF& gltf, const Primitive& primitive, const VertexLayout& layout, ThreadPool* threadPool)
+    {
+        CPPGLTF_ASSERT(CPPGLTF_NULL != streams);
+        s32 numVertices = getNumVertices(gltf, primitive);
+        if(numVertices<0){
+            return false;
+        }
+
+        //Resolve all of the data first, buffers may be loaded lazily
+        Array<VertexSource> sources;
+        sources.resize(layout.getNumElements());
+        for(s32 i=0; i<sources.size(); ++i){
+            sources[i].data_ = CPPGLTF_NULL;
+            sources[i].owned_ = CPPGLTF_NULL;
+        }
+        boolean result = true;
+        for(s32 i=0; i<layout.getNumElements(); ++i){
+            const VertexElement& element = layout.getElement(i);
+            s32 accessor = findAttribute(primitive, element.semanticType_, element.semanticIndex_);
+            if(0<=accessor && !resolveSource(sources[i], gltf, accessor, numVertices)){
+                result = false;
+                break;
+            }
+        }
+
+        if(result){
+            ThreadPool::Function function = [streams, numVertices, &layout, &sources](s32 begin, s32 end){
+                for(s32 i=begin; i<end; ++i){
+                    s32 first = i*InterleaveBlockSize;
+                    s32 count = (numVertices-first<InterleaveBlockSize)? numVertices-first : InterleaveBlockSize;
+                    for(s32 j=0; j<layout.getNumElements(); ++j){
+                        const VertexElement& element = layout.getElement(j);
+                        s32 stride = layout.getStride(element.stream_);
+                        u8* dst = streams[element.stream_] + static_cast<s64>(stride)*first + element.offset_;
+                        convertVertices(dst, stride, element, sources[j], first, count);
+                    }
+                }
+            };
+            s32 numBlocks = (numVertices + InterleaveBlockSize - 1)/InterleaveBlockSize;
+            if(CPPGLTF_NULL != threadPool){
+                threadPool->parallelFor(numBlocks, 1, function);
+            }else{
+                function(0, numBlocks);
+            }
+        }
+
+        for(s32 i=0; i<sources.size(); ++i){
+            CPPGLTF_FREE(sources[i].owned_);
+        }
+        return result;
+    }
+
+    //---------------------------------------------------------------
+    //---
+    //--- Index
+    //---
+    //---------------------------------------------------------------
+namespace
+{
+    template<class T, class U>
+    inline void copyIndices(T* dst, s32 count, const U* src)
+    {
+        for(s32 i=0; i<count; ++i){
+            dst[i] = static_cast<T>(src[i]);
+        }
+    }
+
+    void widenIndices(u32* dst, s32 count, const u8* src)
+    {
+        s32 i = 0;
+#ifdef CPPGLTF_AVX2
+        for(; i+8<=count; i+=8){
+            __m256i x = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src+i)));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst+i), x);
+        }
+#endif
+#ifdef CPPGLTF_SSE2
+        {
+            const __m128i zero = _mm_setzero_si128();
+            for(; i+16<=count; i+=16){
+                __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src+i));
+                __m128i lo = _mm_unpacklo_epi8(x, zero);
+                __m128i hi = _mm_unpackhi_epi8(x, zero);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst+i), _mm_unpacklo_epi16(lo, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst+i+4), _mm_unpackhi_epi16(lo, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst+i+8), _mm_unpacklo_epi16(hi, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst+i+12), _mm_unpackhi_epi16(hi, zero));
+            }
+        }
+#endif
+        copyIndices(dst+i, count-i, src+i);
+    }
+
+    void widenIndices(u32* dst, s32 count, const u16* src)
+    {
+        s32 i = 0;
+#ifdef CPPGLTF_AVX2
+        for(; i+8<=count; i+=8){
+            __m256i x = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src+i)));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst+i), x);
+        }
+#endif
+#ifdef CPPGLTF_SSE2
+        {
+            const __m128i zero = _mm_setzero_si128();
+            for(; i+8<=count; i+=8){
+                __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src+i));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst+i), _mm_unpacklo_epi16(x, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst+i+4), _mm_unpackhi_epi16(x, zero));
+            }
+        }
+#endif
+        copyIndices(dst+i, count-i, src+i);
+    }
+
+    void widenIndices(u16* dst, s32 count, const u8* src)
+    {
+        s32 i = 0;
+#ifdef CPPGLTF_SSE2
+        {
+            const __m128i zero = _mm_setzero_si128();
+            for(; i+16<=count; i+=16){
+                __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src+i));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst+i), _mm_unpacklo_epi8(x, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst+i+8), _mm_unpackhi_epi8(x, zero));
+            }
+        }
+#endif
+        copyIndices(dst+i, count-i, src+i);
+    }
+
+    /**
+    @brief Narrow indices which are checked to be under 65536
+    */
+    void narrowIndices(u16* dst, s32 count, const u32* src)
+    {
+        s32 i = 0;
+#ifdef CPPGLTF_SSE2
+        for(; i+8<=count; i+=8){
+            __m128i x0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src+i));
+            __m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src+i+4));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst+i), packU16(x0, x1));
+        }
+#endif
+        copyIndices(dst+i, count-i, src+i);
+    }
+
+    template<class T>
+    void fillSequential(T* dst, s32 count)
+    {
+        s32 i = 0;
+#ifdef CPPGLTF_SSE2
+        {
+            static const s32 Lanes = 16/sizeof(T);
+            __m128i x = (4 == sizeof(T))? _mm_setr_epi32(0, 1, 2, 3) : _mm_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7);
+            const __m128i step = (4 == sizeof(T))? _mm_set1_epi32(Lanes) : _mm_set1_epi16(Lanes);
+            for(; i+Lanes<=count; i+=Lanes){
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst+i), x);
+                x = (4 == sizeof(T))? _mm_add_epi32(x, step) : _mm_add_epi16(x, step);
+            }
+        }
+#endif
+        for(; i<count; ++i){
+            dst[i] = static_cast<T>(i);
+        }
+    }
+
+    class SequentialIndices
+    {
+    public:
+        inline u32 operator[](s32 index) const
+        {
+            return static_cast<u32>(index);
+        }
+    };
+
+    /**
+    @brief Convert count indices of strips, fans or loops into a list
+    */
+    template<class T, class U>
+    void expandIndices(T* dst, s32 mode, s32 count, const U& src)
+    {
+        switch(mode){
+        case GLTF_PRIMITIVE_LINE_LOOP:
+        case GLTF_PRIMITIVE_LINE_STRIP:
+            for(s32 i=0; i+1<count; ++i){
+                dst[0] = static_cast<T>(src[i]);
+                dst[1] = static_cast<T>(src[i+1]);
+                dst += 2;
+            }
+            if(GLTF_PRIMITIVE_LINE_LOOP == mode && 2<=count){
+                dst[0] = static_cast<T>(src[count-1]);
+                dst[1] = static_cast<T>(src[0]);
+            }
+            break;
+        case GLTF_PRIMITIVE_TRIANGLE_STRIP:
+            //Swap the last two of odd triangles to keep the winding
+            for(s32 i=0; i+2<count; ++i){
+                s32 odd = i&1;
+                dst[0] = static_cast<T>(src[i]);
+                dst[1] = static_cast<T>(src[i+1+odd]);
+                dst[2] = static_cast<T>(src[i+2-odd]);
+                dst += 3;
+            }
+            break;
+        case GLTF_PRIMITIVE_TRIANGLE_FAN:
+            for(s32 i=0; i+2<count; ++i){
+                dst[0] = static_cast<T>(src[i+1]);
+                dst[1] = static_cast<T>(src[i+2]);
+                dst[2] = static_cast<T>(src[0]);
+                dst += 3;
+            }
+            break;
+        default:
+            for(s32 i=0; i<count; ++i){
+                dst[i] = static_cast<T>(src[i]);
+            }
+            break;
+        }
+    }
+
+    template<class T>
+    boolean convertIndicesTo(T* dst, s32 componentType, s32 count, const void* src)
+    {
+        CPPGLTF_ASSERT(0==count || (CPPGLTF_NULL != dst && CPPGLTF_NULL != src));
+        switch(componentType){
+        case GLTF_TYPE_UNSIGNED_BYTE:
+            widenIndices(dst, count, reinterpret_cast<const u8*>(src));
+            return true;
+        case GLTF_TYPE_UNSIGNED_SHORT:
+            if(2 == sizeof(T)){
+                ::memcpy(dst, src, static_cast<size_t>(count)*sizeof(T));
+            }else{
+                widenIndices(reinterpret_cast<u32*>(dst), count, reinterpret_cast<const u16*>(src));
+            }
+            return true;
+        case GLTF_TYPE_UNSIGNED_INT:
+            if(4 == sizeof(T)){
+                ::memcpy(dst, src, static_cast<size_t>(count)*sizeof(T));
+                return true;
+            }
+            if(!checkIndices(reinterpret_cast<const u32*>(src), count, 0x10000U)){
+                return false;
+            }
+            narrowIndices(reinterpret_cast<u16*>(dst), count, reinterpret_cast<const u32*>(src));
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    template<class T, class U>
+    boolean expandIndicesTo(T* dst, s32 mode, s32 count, const u8* src)
+    {
+        const U* indices = reinterpret_cast<const U*>(src);
+        if(sizeof(T)<sizeof(U) && !checkIndices(indices, count, static_cast<u32>(static_cast<T>(-1))+1)){
+            return false;
+        }
+        expandIndices(dst, mode, count, indices);
+        return true;
+    }
+
+    template<class T>
+    boolean getListIndicesTo(T* dst, glTF& gltf, const Primitive& primitive)
+    {
+        s32 mode = primitive.mode_;
+        s32 listMode = getListMode(mode);
+        if(listMode<0){
+            return false;
+        }
+        if(primitive.indices_<0){
+            s32 count = getNumVertices(gltf, primitive);
+            if(count<0 || (0<count && static_cast<u32>(static_cast<T>(-1)) < static_cast<u32>(count-1))){
+                return false;
+            }
+            if(mode == listMode){
+                fillSequential(dst, getNumListIndices(mode, count));
+            }else{
+                expandIndices(dst, mode, count, SequentialIndices());
+            }
+            return true;
+        }
+
+        VertexSource source;
+        source.data_ = CPPGLTF_NULL;
+        source.owned_ = CPPGLTF_NULL;
+        boolean result = resolveSource(source, gltf, primitive.indices_, 0)
+            && 1 == source.numComponents_ && source.stride_ == getComponentSize(source.componentType_);
+        if(result){
+            s32 count = gltf.accessors_[primitive.indices_].count_;
+            if(mode == listMode){
+                result = convertIndicesTo(dst, source.componentType_, getNumListIndices(mode, count), source.data_);
+            }else{
+                switch(source.componentType_){
+                case GLTF_TYPE_UNSIGNED_BYTE:
+                    result = expandIndicesTo<T, u8>(dst, mode, count, source.data_);
+                    break;
+                case GLTF_TYPE_UNSIGNED_SHORT:
+                    result = expandIndicesTo<T, u16>(dst, mode, count, source.data_);
+                    break;
+                case GLTF_TYPE_UNSIGNED_INT:
+                    result = expandIndicesTo<T, u32>(dst, mode, count, source.data_);
+                    break;
+                default:
+                    result = false;
+                    break;
+                }
+            }
+        }
+        CPPGLTF_FREE(source.owned_);
+        return result;
     }
+}
 
-    void glTF::allocate(u32 size)
+    boolean convertIndices(u32* dst, s32 componentType, s32 count, const void* src)
     {
-        CPPGLTF_FREE(bin_);
-        size_ = size;
-        bin_ = (u8*)CPPGLTF_MALLOC(size_);
+        return convertIndicesTo(dst, componentType, count, src);
     }
 
-    u32 glTF::size() const
+    boolean convertIndices(u16* dst, s32 componentType, s32 count, const void* src)
     {
-        return size_;
+        return convertIndicesTo(dst, componentType, count, src);
     }
 
-    const u8* glTF::getBin(u32 offset) const
+    s32 getListMode(s32 mode)
     {
-        CPPGLTF_ASSERT(offset<size_);
-        return bin_+offset;
+        switch(mode){
+        case GLTF_PRIMITIVE_POINTS:
+            return GLTF_PRIMITIVE_POINTS;
+        case GLTF_PRIMITIVE_LINES:
+        case GLTF_PRIMITIVE_LINE_LOOP:
+        case GLTF_PRIMITIVE_LINE_STRIP:
+            return GLTF_PRIMITIVE_LINES;
+        case GLTF_PRIMITIVE_TRIANGLES:
+        case GLTF_PRIMITIVE_TRIANGLE_STRIP:
+        case GLTF_PRIMITIVE_TRIANGLE_FAN:
+            return GLTF_PRIMITIVE_TRIANGLES;
+        default:
+            return -1;
+        }
+    }
+
+    s32 getNumListIndices(s32 mode, s32 count)
+    {
+        switch(mode){
+        case GLTF_PRIMITIVE_POINTS:
+            return (0<count)? count : 0;
+        case GLTF_PRIMITIVE_LINES:
+            return (0<count)? count & ~1 : 0;
+        case GLTF_PRIMITIVE_LINE_LOOP:
+            return (2<=count)? 2*count : 0;
+        case GLTF_PRIMITIVE_LINE_STRIP:
+            return (2<=count)? 2*(count-1) : 0;
+        case GLTF_PRIMITIVE_TRIANGLES:
+            return (0<count)? count - count%3 : 0;
+        case GLTF_PRIMITIVE_TRIANGLE_STRIP:
+        case GLTF_PRIMITIVE_TRIANGLE_FAN:
+            return (3<=count)? 3*(count-2) : 0;
+        default:
+            return -1;
+        }
     }
 
-    u8* glTF::getBin(u32 offset)
+    s32 getNumListIndices(glTF& gltf, const Primitive& primitive)
     {
-        CPPGLTF_ASSERT(offset<size_);
-        return bin_+offset;
+        s32 count;
+        if(primitive.indices_<0){
+            count = getNumVertices(gltf, primitive);
+        }else{
+            count = (primitive.indices_<gltf.accessors_.size())? gltf.accessors_[primitive.indices_].count_ : -1;
+        }
+        return (0<=count)? getNumListIndices(primitive.mode_, count) : -1;
     }
 
-    void glTF::allocateGLB(u32 size)
+    boolean getListIndices(u32* dst, glTF& gltf, const Primitive& primitive)
     {
-        CPPGLTF_FREE(glbBin_);
-        glbSize_ = size;
-        glbBin_ = (u8*)CPPGLTF_MALLOC(glbSize_);
+        return getListIndicesTo(dst, gltf, primitive);
     }
 
-    u32 glTF::sizeGLB() const
+    boolean getListIndices(u16* dst, glTF& gltf, const Primitive& primitive)
     {
-        return glbSize_;
+        return getListIndicesTo(dst, gltf, primitive);
     }
 
-    const u8* glTF::getGLB(u32 offset) const
+    //---------------------------------------------------------------
+    //---
+    //--- glTFHandler
+    //---
+    //---------------------------------------------------------------
+    glTFHandler::glTFHandler()
+        :numThreads_(0)
     {
-        CPPGLTF_ASSERT(offset<glbSize_);
-        return glbBin_+offset;
     }
 
-    u8* glTF::getGLB(u32 offset)
+    glTFHandler::glTFHandler(const Char* directory)
+        :numThreads_(0)
     {
-        CPPGLTF_ASSERT(offset<glbSize_);
-        return glbBin_+offset;
+        gltf_.setDirectory(directory);
     }
 
-    void glTF::traverse(s32 rootScene, std::function<void(const Node&, const glTF&)>func) const
+    glTFHandler::~glTFHandler()
     {
-        const Scene& scene = scenes_[rootScene];
-        for(s32 i = 0; i<scene.nodes_.size(); ++i){
-            traverseChildren(scene.nodes_[i], func);
-        }
     }
 
-    void glTF::traverseChildren(s32 rootNode, std::function<void(const Node&, const glTF&)> func) const
+    void glTFHandler::setNumThreads(s32 numThreads)
     {
-        //Go down to descendants
-        const Node& node = nodes_[rootNode];
-        func(node, *this);
-        for(s32 i = 0; i<node.children_.size(); ++i){
-            traverseChildren(node.children_[i], func);
-        }
+        numThreads_ = numThreads;
+        threadPool_.stop();
     }
 
-    void glTF::Counter::operator()(const Node& node, const glTF& gltf)
+    void glTFHandler::parallelFor(s32 count, const ThreadPool::Function& func)
     {
-        numNodes_ += node.children_.size();
-
-        if(0<=node.camera_){
-            ++numCameras_;
-        }
-        if(0<=node.skin_){
-            ++numSkins_;
+        if(Flag_Parallel != (flags_&Flag_Parallel) || count<MinParallelCount || 1 == numThreads_){
+            func(0, count);
+            return;
         }
-        if(0<=node.mesh_){
-            ++numMeshes_;
-
-            const Mesh& mesh = gltf.meshes_[node.mesh_];
-            numPrimitives_ += mesh.primitives_.size();
-
-            //Count textures
-            for(s32 i = 0; i<mesh.primitives_.size(); ++i){
-                const Primitive& primitive = mesh.primitives_[i];
-                if(primitive.material_<0){
-                    continue;
-                }
-                ++numMaterials_;
-                const Material& material = gltf.materials_[primitive.material_];
-                if(0 <= material.pbrMetallicRoughness_.baseColorTexture_.index_) {
-                    ++numTextures_;
-                }
-                if(0 <= material.pbrMetallicRoughness_.baseColorTexture_.index_) {
-                    ++numTextures_;
-                }
-                if(0 <= material.pbrMetallicRoughness_.metallicRoughnessTexture_.index_) {
-                    ++numTextures_;
-                }
-                if(0 <= material.normalTexture_.index_) {
-                    ++numTextures_;
-                }
-                if(0 <= material.occlusionTexture_.index_) {
-                    ++numTextures_;
-                }
-                if(0 <= material.emissiveTexture_.index_) {
-                    ++numTextures_;
-                }
-            }//for(s32 i
-        }//if(0<=node.mesh_)
+        ThreadPool& threadPool = getThreadPool();
+        //Several chunks per thread to balance uneven elements
+        s32 chunkSize = count/((threadPool.size()+1)*8);
+        chunkSize = (chunkSize<16)? 16 : chunkSize;
+        threadPool.parallelFor(count, chunkSize, func);
     }
 
-    void glTF::getSortedNodes(SortNode* nodes) const
+    ThreadPool& glTFHandler::getThreadPool()
     {
-        //add root nodes
-        s32 rootCount=0;
-        for(s32 i=0; i<nodes_.size(); ++i){
-            if(isRoot(i, nodes_)){
-                nodes[rootCount].oldId_ = i;
-                nodes[rootCount].parent_ = -1;
-                nodes[rootCount].numChildren_ = 0;
-                nodes[rootCount].childrenStart_ = -1;
-                ++rootCount;
-            }
-        }
-
-        //By the glTF specification, a node hierarchy must be a strict tree.
-        //So this algorithm works, and will end sometime.
-        s32 count = rootCount;
-        for(s32 i=0; i<rootCount; ++i){
-            count = addChildren(i, count, nodes, nodes_);
+        if(threadPool_.size()<=0){
+            threadPool_.start((0<numThreads_)? numThreads_-1 : 0);
         }
+        return threadPool_;
     }
 
-    boolean glTF::isRoot(s32 node, const Array<Node>& nodes)
+    void glTFHandler::getDataURI(Buffer& buffer, const JSAny& value) const
     {
-        for(s32 i=0; i<nodes.size(); ++i){
-            for(s32 j=0; j<nodes[i].children_.size(); ++j){
-                if(node == nodes[i].children_[j]){
-                    return false;
-                }
-            }
+        if(JSON_Source != value.type_){
+            getString(buffer.uri_, value);
+            return;
         }
-        return true;
-    }
-
-    s32 glTF::addChildren(s32 parent, s32 dstSize, SortNode* dst, const Array<Node>& nodes)
-    {
-        const Node& parentNode = nodes[dst[parent].oldId_];
-        dst[parent].childrenStart_ = dstSize;
-        dst[parent].numChildren_ = parentNode.children_.size();
-        //add children
-        for(s32 i=0; i<parentNode.children_.size(); ++i){
-            SortNode& n = dst[dstSize];
-            n.oldId_ = parentNode.children_[i];
-            n.parent_ = parent;
-            n.numChildren_ = nodes[n.oldId_].children_.size();
-            n.childrenStart_ = -1;
-            ++dstSize;
+        const Char* comma = static_cast<const Char*>(::memchr(value.source_, ',', value.num_));
+        if(CPPGLTF_NULL == comma){
+            getString(buffer.uri_, value);
+            return;
         }
-        return dstSize;
-    }
-
-    //---------------------------------------------------------------
-    //---
-    //--- glTFHandler
-    //---
-    //---------------------------------------------------------------
-    glTFHandler::glTFHandler()
-    {
-    }
-
-    glTFHandler::glTFHandler(const Char* directory)
-    {
-        gltf_.setDirectory(directory);
+        s32 header = static_cast<s32>(comma - value.source_) + 1;
+        if(header != static_cast<s32>(::strlen(Base64URL)) || 0 != ::memcmp(value.source_, Base64URL, header)){
+            getString(buffer.uri_, value);
+            return;
+        }
+        buffer.uri_.assign(header, value.source_);
+        buffer.source_ = value.source_ + header;
+        buffer.sourceLength_ = value.num_ - header;
     }
 
-    glTFHandler::~glTFHandler()
+    void glTFHandler::begin()
     {
+        glTFBase::begin();
+        gltf_.initialize();
     }
 
     void glTFHandler::parseGlTF(const JSAny& glTF)
     {
-        gltf_.initialize();
         for(s32 i=0; i<glTF.num_; ++i){
             JSKeyValue& kv = glTF.object_[i];
             switch(kv.key_){
@@ -5340,15 +10308,19 @@ namespace
                 break;
             case GLTF_ACCESSORS:
                 expand(gltf_.accessors_, kv.value_);
-                for(s32 j=0; j<kv.value_.num_; ++j){
-                    parseAccessor(gltf_.accessors_[j], kv.value_.array_[j]);
-                }
+                parallelFor(kv.value_.num_, [this, &kv](s32 begin, s32 end){
+                    for(s32 j=begin; j<end; ++j){
+                        parseAccessor(gltf_.accessors_[j], kv.value_.array_[j]);
+                    }
+                });
                 break;
             case GLTF_ANIMATIONS:
                 expand(gltf_.animations_, kv.value_);
-                for(s32 j=0; j<kv.value_.num_; ++j){
-                    parseAnimation(gltf_.animations_[j], kv.value_.array_[j]);
-                }
+                parallelFor(kv.value_.num_, [this, &kv](s32 begin, s32 end){
+                    for(s32 j=begin; j<end; ++j){
+                        parseAnimation(gltf_.animations_[j], kv.value_.array_[j]);
+                    }
+                });
                 break;
             case GLTF_ASSET:
                 parseAsset(gltf_.asset_, kv.value_);
@@ -5379,21 +10351,27 @@ namespace
                 break;
             case GLTF_MATERIALS:
                 expand(gltf_.materials_, kv.value_);
-                for(s32 j=0; j<kv.value_.num_; ++j){
-                    parseMaterial(gltf_.materials_[j], kv.value_.array_[j]);
-                }
+                parallelFor(kv.value_.num_, [this, &kv](s32 begin, s32 end){
+                    for(s32 j=begin; j<end; ++j){
+                        parseMaterial(gltf_.materials_[j], kv.value_.array_[j]);
+                    }
+                });
                 break;
             case GLTF_MESHES:
                 expand(gltf_.meshes_, kv.value_);
-                for(s32 j=0; j<kv.value_.num_; ++j){
-                    parseMesh(gltf_.meshes_[j], kv.value_.array_[j]);
-                }
+                parallelFor(kv.value_.num_, [this, &kv](s32 begin, s32 end){
+                    for(s32 j=begin; j<end; ++j){
+                        parseMesh(gltf_.meshes_[j], kv.value_.array_[j]);
+                    }
+                });
                 break;
             case GLTF_NODES:
                 expand(gltf_.nodes_, kv.value_);
-                for(s32 j=0; j<kv.value_.num_; ++j){
-                    parseNode(gltf_.nodes_[j], kv.value_.array_[j]);
-                }
+                parallelFor(kv.value_.num_, [this, &kv](s32 begin, s32 end){
+                    for(s32 j=begin; j<end; ++j){
+                        parseNode(gltf_.nodes_[j], kv.value_.array_[j]);
+                    }
+                });
                 break;
             case GLTF_SAMPLERS:
                 expand(gltf_.samplers_, kv.value_);
@@ -5431,7 +10409,81 @@ namespace
             }
         }
 
-        gltf_.loadBuffers();
+        if(Flag_DeferBuffers != (flags_&Flag_DeferBuffers)){
+            loadBuffers();
+        }
+    }
+
+    boolean glTFHandler::loadBuffers()
+    {
+        //Loading files is worth the threads even for a couple of buffers, and so is decoding a large data URI
+        boolean parallel = false;
+        if(Flag_Parallel == (flags_&Flag_Parallel) && 1 != numThreads_){
+            parallel = 1<gltf_.buffers_.size();
+            for(s32 i=0; i<gltf_.buffers_.size() && !parallel; ++i){
+                parallel = MinParallelDecode<=gltf_.buffers_[i].sourceLength_ || MinParallelDecode<=gltf_.buffers_[i].uri_.length();
+            }
+        }
+        u32 loadFlags = 0;
+        loadFlags |= (Flag_MapBuffers == (flags_&Flag_MapBuffers))? glTF::Flag_MapBuffers : 0;
+        loadFlags |= (Flag_LazyBuffers == (flags_&Flag_LazyBuffers))? glTF::Flag_LazyBuffers : 0;
+        boolean result = gltf_.loadBuffers(parallel? &getThreadPool() : CPPGLTF_NULL, loadFlags);
+        //The sources of data URIs are gone after reading, uri_ keeps only the header
+        for(s32 i=0; i<gltf_.buffers_.size(); ++i){
+            Buffer& buffer = gltf_.buffers_[i];
+            if(CPPGLTF_NULL != buffer.source_){
+                buffer.source_ = CPPGLTF_NULL;
+                buffer.sourceLength_ = -1;
+            }
+        }
+        return result;
+    }
+
+    boolean glTFHandler::parseElement(s32 key, s32 index, const JSAny& value)
+    {
+        switch(key){
+        case GLTF_ACCESSORS:
+            parseAccessor(expandElement(gltf_.accessors_, index), value);
+            return true;
+        case GLTF_ANIMATIONS:
+            parseAnimation(expandElement(gltf_.animations_, index), value);
+            return true;
+        case GLTF_BUFFERS:
+            parseBuffer(expandElement(gltf_.buffers_, index), value);
+            return true;
+        case GLTF_BUFFERVIEWS:
+            parseBufferView(expandElement(gltf_.bufferViews_, index), value);
+            return true;
+        case GLTF_CAMERAS:
+            parseCamera(expandElement(gltf_.cameras_, index), value);
+            return true;
+        case GLTF_IMAGES:
+            parseImage(expandElement(gltf_.images_, index), value);
+            return true;
+        case GLTF_MATERIALS:
+            parseMaterial(expandElement(gltf_.materials_, index), value);
+            return true;
+        case GLTF_MESHES:
+            parseMesh(expandElement(gltf_.meshes_, index), value);
+            return true;
+        case GLTF_NODES:
+            parseNode(expandElement(gltf_.nodes_, index), value);
+            return true;
+        case GLTF_SAMPLERS:
+            parseSampler(expandElement(gltf_.samplers_, index), value);
+            return true;
+        case GLTF_SCENES:
+            parseScene(expandElement(gltf_.scenes_, index), value);
+            return true;
+        case GLTF_SKINS:
+            parseSkin(expandElement(gltf_.skins_, index), value);
+            return true;
+        case GLTF_TEXTURES:
+            parseTexture(expandElement(gltf_.textures_, index), value);
+            return true;
+        default:
+            return false;
+        }
     }
 
     void glTFHandler::parseAccessor(Accessor& accessor, const JSAny& value)
@@ -5448,7 +10500,7 @@ namespace
                 accessor.bufferView_ = kv.value_.int_;
                 break;
             case GLTF_BYTEOFFSET:
-                accessor.byteOffset_ = kv.value_.int_;
+                accessor.byteOffset_ = getInteger(kv.value_);
                 break;
             case GLTF_COMPONENTTYPE:
                 accessor.componentType_ = kv.value_.int_;
@@ -5460,26 +10512,25 @@ namespace
                 accessor.count_ = kv.value_.int_;
                 break;
             case GLTF_TYPE:
-                getString(key_, kv.value_);
-                if(GLTF_TYPE_NAME_SCALAR == key_){
+                if(equals(kv.value_, GLTF_TYPE_NAME_SCALAR)){
                     accessor.type_ = GLTF_TYPE_SCALAR;
 
-                }else if(GLTF_TYPE_NAME_VEC2 == key_){
+                }else if(equals(kv.value_, GLTF_TYPE_NAME_VEC2)){
                     accessor.type_ = GLTF_TYPE_VEC2;
 
-                }else if(GLTF_TYPE_NAME_VEC3 == key_){
+                }else if(equals(kv.value_, GLTF_TYPE_NAME_VEC3)){
                     accessor.type_ = GLTF_TYPE_VEC3;
 
-                }else if(GLTF_TYPE_NAME_VEC4 == key_){
+                }else if(equals(kv.value_, GLTF_TYPE_NAME_VEC4)){
                     accessor.type_ = GLTF_TYPE_VEC4;
 
-                }else if(GLTF_TYPE_NAME_MAT2 == key_){
+                }else if(equals(kv.value_, GLTF_TYPE_NAME_MAT2)){
                     accessor.type_ = GLTF_TYPE_MAT2;
 
-                }else if(GLTF_TYPE_NAME_MAT3 == key_){
+                }else if(equals(kv.value_, GLTF_TYPE_NAME_MAT3)){
                     accessor.type_ = GLTF_TYPE_MAT3;
 
-                }else if(GLTF_TYPE_NAME_MAT4 == key_){
+                }else if(equals(kv.value_, GLTF_TYPE_NAME_MAT4)){
                     accessor.type_ = GLTF_TYPE_MAT4;
                 }
                 break;
@@ -5549,7 +10600,7 @@ namespace
                 indices.bufferView_ = kv.value_.int_;
                 break;
             case GLTF_BYTEOFFSET:
-                indices.byteOffset_ = kv.value_.int_;
+                indices.byteOffset_ = getInteger(kv.value_);
                 break;
             case GLTF_COMPONENTTYPE:
                 indices.componentType_ = kv.value_.int_;
@@ -5577,7 +10628,7 @@ namespace
                 values.bufferView_ = kv.value_.int_;
                 break;
             case GLTF_BYTEOFFSET:
-                values.byteOffset_ = kv.value_.int_;
+                values.byteOffset_ = getInteger(kv.value_);
                 break;
             case GLTF_EXTENSIONS:
                 parseExtensions(values.extensions_, kv.value_);
@@ -5690,14 +10741,13 @@ namespace
                 sampler.input_ = kv.value_.int_;
                 break;
             case GLTF_INTERPOLATION:
-                getString(key_, kv.value_);
-                if(GLTF_INTERP_NAME_LINEAR == key_){
+                if(equals(kv.value_, GLTF_INTERP_NAME_LINEAR)){
                     sampler.interpolation_ = GLTF_INTERP_LINEAR;
-                }else if(GLTF_INTERP_NAME_STEP == key_){
+                }else if(equals(kv.value_, GLTF_INTERP_NAME_STEP)){
                     sampler.interpolation_ = GLTF_INTERP_STEP;
-                }else if(GLTF_INTERP_NAME_CATMULLROMSPLINE == key_){
+                }else if(equals(kv.value_, GLTF_INTERP_NAME_CATMULLROMSPLINE)){
                     sampler.interpolation_ = GLTF_INTERP_CATMULLROMSPLINE;
-                }else if(GLTF_INTERP_NAME_CUBICSPLINE == key_){
+                }else if(equals(kv.value_, GLTF_INTERP_NAME_CUBICSPLINE)){
                     sampler.interpolation_ = GLTF_INTERP_CUBICSPLINE;
                 }
                 break;
@@ -5755,10 +10805,10 @@ namespace
             JSKeyValue& kv = value.object_[i];
             switch(kv.key_){
             case GLTF_URI:
-                getString(buffer.uri_, kv.value_);
+                getDataURI(buffer, kv.value_);
                 break;
             case GLTF_BYTELENGTH:
-                buffer.byteLength_ = kv.value_.int_;
+                buffer.byteLength_ = getInteger(kv.value_);
                 break;
             case GLTF_NAME:
                 getString(buffer.name_, kv.value_);
@@ -5786,10 +10836,10 @@ namespace
                 bufferView.buffer_ = kv.value_.int_;
                 break;
             case GLTF_BYTEOFFSET:
-                bufferView.byteOffset_ = kv.value_.int_;
+                bufferView.byteOffset_ = getInteger(kv.value_);
                 break;
             case GLTF_BYTELENGTH:
-                bufferView.byteLength_ = kv.value_.int_;
+                bufferView.byteLength_ = getInteger(kv.value_);
                 break;
             case GLTF_BYTESTRIDE:
                 bufferView.byteStride_ = kv.value_.int_;
@@ -5820,16 +10870,15 @@ namespace
             JSKeyValue& kv = value.object_[i];
             switch(kv.key_){
             case GLTF_ORTHOGRAPHIC:
-                parseOrthographic(camera.orthographic_, value);
+                parseOrthographic(camera.orthographic_, kv.value_);
                 break;
             case GLTF_PERSPECTIVE:
-                parsePerspective(camera.perspective_, value);
+                parsePerspective(camera.perspective_, kv.value_);
                 break;
             case GLTF_TYPE:
-                getString(key_, value);
-                if(GLTF_CAMERA_TYPE_NAME_PERSPECTIVE == key_){
+                if(equals(kv.value_, GLTF_CAMERA_TYPE_NAME_PERSPECTIVE)){
                     camera.type_ = GLTF_CAMERA_TYPE_PERSPECTIVE;
-                }else if(GLTF_CAMERA_TYPE_NAME_ORTHOGRAPHIC == key_){
+                }else if(equals(kv.value_, GLTF_CAMERA_TYPE_NAME_ORTHOGRAPHIC)){
                     camera.type_ = GLTF_CAMERA_TYPE_ORTHOGRAPHIC;
                 }
                 break;
@@ -5967,12 +11016,11 @@ namespace
                 getVec3(material.emissiveFactor_, kv.value_);
                 break;
             case GLTF_ALPHAMODE:
-                getString(key_, kv.value_);
-                if(GLTF_ALPHAMODE_NAME_OPAQUE == key_){
+                if(equals(kv.value_, GLTF_ALPHAMODE_NAME_OPAQUE)){
                     material.alphaMode_ = GLTF_ALPHAMODE_OPAQUE;
-                }else if(GLTF_ALPHAMODE_NAME_MASK == key_){
+                }else if(equals(kv.value_, GLTF_ALPHAMODE_NAME_MASK)){
                     material.alphaMode_ = GLTF_ALPHAMODE_MASK;
-                }else if(GLTF_ALPHAMODE_NAME_BLEND == key_){
+                }else if(equals(kv.value_, GLTF_ALPHAMODE_NAME_BLEND)){
                     material.alphaMode_ = GLTF_ALPHAMODE_BLEND;
                 }
                 break;
@@ -6600,13 +11648,122 @@ namespace
             break;
         }
         glTF& gltf = handler_.get();
-        gltf.allocateGLB(static_cast<u32>(size));
+        const u8* data = istream_.data();
+        if(glTFBase::Flag_ReferenceGLB == (handler_.getFlags()&glTFBase::Flag_ReferenceGLB) && CPPGLTF_NULL != data){
+            off_t offset = istream_.tell();
+            if(istream_.size()<offset+size){
+                return false;
+            }
+            gltf.referenceGLB(size, const_cast<u8*>(data+offset));
+            return istream_.seek(offset+size);
+        }
+        gltf.allocateGLB(size);
         if(istream_.read(gltf.getGLB(0), size) <= 0){
             return false;
         }
         return true;
     }
 
+    //---------------------------------------------------------------
+    //---
+    //--- AsyncLoader
+    //---
+    //---------------------------------------------------------------
+    AsyncLoader::AsyncLoader()
+        :state_(State_Idle)
+        ,running_(false)
+    {
+    }
+
+    AsyncLoader::~AsyncLoader()
+    {
+        wait();
+    }
+
+    boolean AsyncLoader::start(const Char* filepath, u32 flags, Callback onJSON, Callback onBuffers)
+    {
+        CPPGLTF_ASSERT(CPPGLTF_NULL != filepath);
+        //Set before the worker exists, the callbacks on it are refused without joining itself
+        if(running_.exchange(true, std::memory_order_acq_rel)){
+            return false;
+        }
+        wait();
+
+        //Buffers are relative to the file
+        const Char* separator = CPPGLTF_NULL;
+        for(const Char* c = filepath; '\0' != *c; ++c){
+            if('/' == *c || '\\' == *c){
+                separator = c;
+            }
+        }
+        String directory;
+        if(CPPGLTF_NULL != separator){
+            directory.assign(static_cast<s32>(separator-filepath+1), filepath);
+        }
+        handler_.get().setDirectory(directory.c_str());
+
+        //The mapped file is kept until the buffers are loaded, so data URIs and the BIN chunk are used in place
+        handler_.setFlags(flags|glTFBase::Flag_ReferenceGLB|glTFBase::Flag_DeferBuffers);
+        if(!istream_.open(filepath)){
+            state_.store(State_Failed, std::memory_order_release);
+            running_.store(false, std::memory_order_release);
+            return false;
+        }
+        state_.store(State_Parsing, std::memory_order_release);
+        thread_ = std::thread(&AsyncLoader::run, this, std::move(onJSON), std::move(onBuffers));
+        return true;
+    }
+
+    void AsyncLoader::wait()
+    {
+        if(thread_.joinable()){
+            thread_.join();
+        }
+    }
+
+    void AsyncLoader::run(Callback onJSON, Callback onBuffers)
+    {
+        u32 magic = 0;
+        if(CPPGLTF_NULL != istream_.data() && static_cast<s64>(sizeof(u32))<=istream_.size()){
+            ::memcpy(&magic, istream_.data(), sizeof(u32));
+        }
+        boolean glb = GLBReader::Magic == magic;
+        boolean result;
+        if(glb){
+            GLBReader reader(istream_, handler_);
+            result = reader.read();
+        }else{
+            JSONReader reader(istream_, handler_);
+            result = reader.read();
+        }
+        if(result){
+            state_.store(State_LoadingBuffers, std::memory_order_release);
+            if(onJSON){
+                onJSON(*this);
+            }
+            result = handler_.loadBuffers();
+        }
+        if(glb){
+            //The BIN chunk and the buffers in it are referenced in place, even if failed
+            handler_.get().holdStorage(std::move(istream_));
+        }else{
+            //Data URIs left in the file are not loaded if failed before the buffers
+            glTF& gltf = handler_.get();
+            for(s32 i=0; i<gltf.buffers_.size(); ++i){
+                if(CPPGLTF_NULL != gltf.buffers_[i].source_){
+                    gltf.buffers_[i].source_ = CPPGLTF_NULL;
+                    gltf.buffers_[i].sourceLength_ = -1;
+                }
+            }
+            istream_.close();
+        }
+        state_.store(result? State_Done : State_Failed, std::memory_order_release);
+        if(onBuffers){
+            onBuffers(*this);
+        }
+        running_.store(false, std::memory_order_release);
+    }
+
     //---------------------------------------------------------------
     //---
     //--- glTFWriter
@@ -6714,7 +11871,13 @@ namespace
             GLBReader::Header header;
             header.magic_ = GLBReader::Magic;
             header.version_ = GLBReader::Version;
-            header.length_ = osstream.size() + gltf.sizeGLB() + sizeof(GLBReader::Chunk)*2;
+            //Lengths in GLB are 32 bits
+            s64 length = osstream.size() + gltf.sizeGLB() + sizeof(GLBReader::Chunk)*2;
+            if(0xFFFFFFFFLL<length){
+                gltf_ = CPPGLTF_NULL;
+                return false;
+            }
+            header.length_ = static_cast<u32>(length);
             ostream1_->write(header);
 
             GLBReader::Chunk chunk;
@@ -6723,10 +11886,13 @@ namespace
             ostream1_->write(chunk);
             ostream1_->write(osstream.size(), osstream.buff());
 
-            chunk.length_ = gltf.sizeGLB();
+            chunk.length_ = static_cast<u32>(gltf.sizeGLB());
             chunk.type_ = GLBReader::ChunkType_BIN;
             ostream1_->write(chunk);
-            ostream1_->write(gltf.sizeGLB(), gltf.getGLB(0));
+            for(s64 offset = 0; offset<gltf.sizeGLB(); offset += MaxIOChunk){
+                s64 size = gltf.sizeGLB()-offset;
+                ostream1_->write(static_cast<s32>(size<MaxIOChunk? size : MaxIOChunk), gltf.getGLB(offset));
+            }
         }
             break;
         default:
@@ -6784,7 +11950,10 @@ namespace
 #if _MSC_VER
         s32 length = _vscprintf(str, args);
 #else
-        s32 length = vscprintf(str, args);
+        va_list count;
+        va_copy(count, args);
+        s32 length = ::vsnprintf(CPPGLTF_NULL, 0, str, count);
+        va_end(count);
 #endif
         static const s32 MaxBuffer = 128;
         Char buffer[MaxBuffer];
@@ -6798,7 +11967,7 @@ namespace
 #if defined(_WIN32) || defined(_WIN64)
         vsnprintf_s(buff, MaxBuffer, length, str, args);
 #else
-        ::vsnprintf(buff, length, str, args);
+        ::vsnprintf(buff, length+1, str, args);
 #endif //defined(_WIN32) || defined(_WIN64)
         ostream1_->write(length, buff);
         if(buffer != buff){
@@ -6835,6 +12004,12 @@ namespace
         return true;
     }
 
+    bool glTFWriter::print(s64 value)
+    {
+        format("%lld", static_cast<long long>(value));
+        return true;
+    }
+
     bool glTFWriter::print(f32 value)
     {
         format("%0.1f", value);
@@ -6904,6 +12079,15 @@ namespace
         printSeparatorLine();
     }
 
+    void glTFWriter::printObjectProperty(const Char* key, s64 value)
+    {
+        printIndent();
+        print(key);
+        printKeyValueSeparator();
+        print(value);
+        printSeparatorLine();
+    }
+
     void glTFWriter::printObjectProperty(const Char* key, f32 value)
     {
         printIndent();
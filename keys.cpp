@@ -1,120 +1,129 @@
 namespace {
-    struct Word{ u32 hash_; const char* str_;};
+    struct Word{ s32 code_; s32 length_; const char* str_;};
     static const s32 NumWords = 113;
-    const Word words[] =
+    static const s32 NumKeyBuckets = 29;
+    constexpr u16 keyDisplacements[NumKeyBuckets] =
     {
-        {3733770766U,"BUFFERVIEW"},
-        {1736982884U,"BYTEOFFSET"},
-        {535965544U,"COMPONENTTYPE"},
-        {759490392U,"NORMALIZED"},
-        {2750919380U,"COUNT"},
-        {338683789U,"TYPE"},
-        {475632249U,"MAX"},
-        {239465655U,"MIN"},
-        {413982885U,"SPARSE"},
-        {1387956774U,"NAME"},
-        {1482583691U,"EXTENSIONS"},
-        {1617560430U,"EXTRAS"},
-        {2180989045U,"CHANNELS"},
-        {864986484U,"SAMPLERS"},
-        {1638025307U,"INPUT"},
-        {3457493885U,"INTERPOLATION"},
-        {1469629700U,"OUTPUT"},
-        {2970901150U,"COPYRIGHT"},
-        {622175778U,"GENERATOR"},
-        {3552295351U,"VERSION"},
-        {3706427545U,"MINVERSION"},
-        {2053729053U,"URI"},
-        {1037972015U,"BYTELENGTH"},
-        {4289874747U,"BUFFER"},
-        {417073434U,"BYTESTRIDE"},
-        {4080126536U,"TARGET"},
-        {4050703019U,"ORTHOGRAPHIC"},
-        {2423545653U,"PERSPECTIVE"},
-        {4060151151U,"SAMPLER"},
-        {1499262730U,"EXTENSIONSUSED"},
-        {996948758U,"EXTENSIONSREQUIRED"},
-        {2414822891U,"ACCESSORS"},
-        {1789696170U,"ANIMATIONS"},
-        {2283815739U,"ASSET"},
-        {3987518648U,"BUFFERS"},
-        {3031378023U,"BUFFERVIEWS"},
-        {2550069799U,"CAMERAS"},
-        {1881178923U,"IMAGES"},
-        {1393374089U,"MATERIALS"},
-        {4206430392U,"MESHES"},
-        {3675200826U,"NODES"},
-        {51960179U,"SCENE"},
-        {1953120U,"SCENES"},
-        {1702551537U,"SKINS"},
-        {3346351557U,"TEXTURES"},
-        {3540378101U,"MIMETYPE"},
-        {2464862628U,"PBRMETALLICROUGHNESS"},
-        {3405345669U,"NORMALTEXTURE"},
-        {1228653941U,"OCCLUSIONTEXTURE"},
-        {3330026097U,"EMISSIVETEXTURE"},
-        {2025219817U,"EMISSIVEFACTOR"},
-        {3200287092U,"ALPHAMODE"},
-        {2113210782U,"ALPHACUTOFF"},
-        {1515629509U,"DOUBLESIDED"},
-        {3884336095U,"PRIMITIVES"},
-        {3302258910U,"WEIGHTS"},
-        {1150800334U,"CAMERA"},
-        {25294226U,"CHILDREN"},
-        {1891474104U,"SKIN"},
-        {3232719852U,"MATRIX"},
-        {1253731580U,"MESH"},
-        {1306169695U,"ROTATION"},
-        {594488785U,"SCALE"},
-        {2352925580U,"TRANSLATION"},
-        {2977188619U,"INDEX"},
-        {197415955U,"TEXCOORD"},
-        {1190385072U,"STRENGTH"},
-        {2641395134U,"XMAG"},
-        {4266306379U,"YMAG"},
-        {3102316870U,"ZFAR"},
-        {3547621959U,"ZNEAR"},
-        {1281948832U,"BASECOLORFACTOR"},
-        {2523291950U,"BASECOLORTEXTURE"},
-        {3732260891U,"METALLICFACTOR"},
-        {3032623030U,"ROUGHNESSFACTOR"},
-        {3979861821U,"METALLICROUGHNESSTEXTURE"},
-        {770814808U,"ASPECTRATIO"},
-        {3573915575U,"YFOV"},
-        {2183160468U,"ATTRIBUTES"},
-        {3304816210U,"INDICES"},
-        {2401933216U,"MATERIAL"},
-        {3593007890U,"MODE"},
-        {4066453633U,"TARGETS"},
-        {2867472150U,"MAGFILTER"},
-        {2384703633U,"MINFILTER"},
-        {3322193538U,"WRAPS"},
-        {3238305443U,"WRAPT"},
-        {622090976U,"INVERSEBINDMATRICES"},
-        {4266997486U,"SKELETON"},
-        {1803683916U,"JOINTS"},
-        {3612181627U,"VALUES"},
-        {2000820813U,"NODE"},
-        {1839435638U,"PATH"},
-        {3111715480U,"SOURCE"},
-        {2013849738U,"POSITION"},
-        {1009949074U,"NORMAL"},
-        {2576630498U,"TANGENT"},
-        {1145745916U,"TEXCOORD_0"},
-        {1162523535U,"TEXCOORD_1"},
-        {1179301154U,"TEXCOORD_2"},
-        {1196078773U,"TEXCOORD_3"},
-        {3429632335U,"COLOR_0"},
-        {3412854716U,"COLOR_1"},
-        {3463187573U,"COLOR_2"},
-        {3446409954U,"COLOR_3"},
-        {3797173403U,"JOINTS_0"},
-        {3780395784U,"JOINTS_1"},
-        {3830728641U,"JOINTS_2"},
-        {3813951022U,"JOINTS_3"},
-        {596967449U,"WEIGHTS_0"},
-        {580189830U,"WEIGHTS_1"},
-        {563412211U,"WEIGHTS_2"},
-        {546634592U,"WEIGHTS_3"},
+        20U, 70U, 22U, 64U, 4U, 16U, 2U, 20U,
+        17U, 1U, 12U, 38U, 47U, 1U, 10U, 66U,
+        102U, 8U, 17U, 22U, 447U, 37U, 86U, 108U,
+        33U, 4328U, 3U, 1620U, 176U,
+    };
+    //Sorted by slots of the perfect hash
+    constexpr Word words[NumWords] =
+    {
+        {76,11,"aspectRatio"},
+        {80,8,"material"},
+        {99,10,"TEXCOORD_2"},
+        {4,5,"count"},
+        {67,4,"xmag"},
+        {24,10,"byteStride"},
+        {60,4,"mesh"},
+        {84,9,"minFilter"},
+        {111,9,"WEIGHTS_2"},
+        {92,4,"path"},
+        {3,10,"normalized"},
+        {46,20,"pbrMetallicRoughness"},
+        {7,3,"min"},
+        {89,6,"joints"},
+        {33,5,"asset"},
+        {90,6,"values"},
+        {13,8,"samplers"},
+        {45,8,"mimeType"},
+        {109,9,"WEIGHTS_0"},
+        {20,10,"minVersion"},
+        {10,10,"extensions"},
+        {53,11,"doubleSided"},
+        {55,7,"weights"},
+        {25,6,"target"},
+        {70,5,"znear"},
+        {49,15,"emissiveTexture"},
+        {58,4,"skin"},
+        {62,5,"scale"},
+        {98,10,"TEXCOORD_1"},
+        {69,4,"zfar"},
+        {105,8,"JOINTS_0"},
+        {51,9,"alphaMode"},
+        {57,8,"children"},
+        {100,10,"TEXCOORD_3"},
+        {77,4,"yfov"},
+        {103,7,"COLOR_2"},
+        {108,8,"JOINTS_3"},
+        {22,10,"byteLength"},
+        {75,24,"metallicRoughnessTexture"},
+        {56,6,"camera"},
+        {112,9,"WEIGHTS_3"},
+        {72,16,"baseColorTexture"},
+        {52,11,"alphaCutoff"},
+        {74,15,"roughnessFactor"},
+        {14,5,"input"},
+        {15,13,"interpolation"},
+        {86,5,"wrapT"},
+        {2,13,"componentType"},
+        {104,7,"COLOR_3"},
+        {78,10,"attributes"},
+        {18,9,"generator"},
+        {91,4,"node"},
+        {66,8,"strength"},
+        {30,18,"extensionsRequired"},
+        {21,3,"uri"},
+        {27,11,"perspective"},
+        {23,6,"buffer"},
+        {88,8,"skeleton"},
+        {8,6,"sparse"},
+        {102,7,"COLOR_1"},
+        {94,8,"POSITION"},
+        {32,10,"animations"},
+        {59,6,"matrix"},
+        {63,11,"translation"},
+        {79,7,"indices"},
+        {17,9,"copyright"},
+        {54,10,"primitives"},
+        {48,16,"occlusionTexture"},
+        {39,6,"meshes"},
+        {35,11,"bufferViews"},
+        {36,7,"cameras"},
+        {87,19,"inverseBindMatrices"},
+        {81,4,"mode"},
+        {11,6,"extras"},
+        {85,5,"wrapS"},
+        {82,7,"targets"},
+        {5,4,"type"},
+        {107,8,"JOINTS_2"},
+        {41,5,"scene"},
+        {16,6,"output"},
+        {38,9,"materials"},
+        {47,13,"normalTexture"},
+        {29,14,"extensionsUsed"},
+        {93,6,"source"},
+        {42,6,"scenes"},
+        {61,8,"rotation"},
+        {73,14,"metallicFactor"},
+        {40,5,"nodes"},
+        {97,10,"TEXCOORD_0"},
+        {37,6,"images"},
+        {31,9,"accessors"},
+        {19,7,"version"},
+        {1,10,"byteOffset"},
+        {106,8,"JOINTS_1"},
+        {96,7,"TANGENT"},
+        {12,8,"channels"},
+        {68,4,"ymag"},
+        {65,8,"texCoord"},
+        {101,7,"COLOR_0"},
+        {34,7,"buffers"},
+        {26,12,"orthographic"},
+        {28,7,"sampler"},
+        {110,9,"WEIGHTS_1"},
+        {43,5,"skins"},
+        {44,8,"textures"},
+        {9,4,"name"},
+        {71,15,"baseColorFactor"},
+        {50,14,"emissiveFactor"},
+        {0,10,"bufferView"},
+        {64,5,"index"},
+        {6,3,"max"},
+        {95,6,"NORMAL"},
+        {83,9,"magFilter"},
     };
 }
@@ -180,6 +180,218 @@ TEST_CASE("A sample Box can be loaded", "[Box]"){
         REQUIRE("" == gltf.buffers_[0].uri_);
     }
 
+    SECTION("load text mapped"){
+        cppgltf::IMMStream istream;
+        if(!istream.open(text)){
+            return;
+        }
+        cppgltf::glTFHandler gltfHandler(textDir);
+        cppgltf::JSONReader gltfJsonReader(istream, gltfHandler);
+        bool result = gltfJsonReader.read();
+        REQUIRE(result);
+        istream.close();
+
+        cppgltf::glTF& gltf = gltfHandler.get();
+        common_check_Box(gltf);
+        REQUIRE(648 == gltf.buffers_[0].byteLength_);
+    }
+
+    SECTION("load binary mapped"){
+        cppgltf::IMMStream istream;
+        if(!istream.open(binary)){
+            return;
+        }
+        cppgltf::GLBEventHandler glbHandler;
+        cppgltf::GLBReader glbReader(istream, glbHandler);
+        bool result = glbReader.read();
+        REQUIRE(result);
+        istream.close();
+
+        cppgltf::glTF& gltf = glbHandler.get();
+        common_check_Box(gltf);
+    }
+
+    SECTION("load binary referencing the mapped file"){
+        cppgltf::GLBEventHandler glbHandler;
+        glbHandler.setFlags(cppgltf::glTFBase::Flag_ReferenceGLB);
+        {
+            cppgltf::IMMStream istream;
+            if(!istream.open(binary)){
+                return;
+            }
+            cppgltf::GLBReader glbReader(istream, glbHandler);
+            bool result = glbReader.read();
+            REQUIRE(result);
+            const cppgltf::u8* data = glbHandler.get().buffers_[0].data_;
+            REQUIRE(istream.data() <= data);
+            REQUIRE(data < istream.data() + istream.size());
+            glbHandler.get().holdStorage(std::move(istream));
+        }
+
+        cppgltf::glTF& gltf = glbHandler.get();
+        common_check_Box(gltf);
+    }
+
+    SECTION("load text streaming"){
+        cppgltf::IFStream ifstream;
+        if(!ifstream.open(text)){
+            return;
+        }
+        cppgltf::glTFHandler gltfHandler(textDir);
+        gltfHandler.setFlags(cppgltf::glTFBase::Flag_Streaming);
+        cppgltf::JSONReader gltfJsonReader(ifstream, gltfHandler);
+        bool result = gltfJsonReader.read();
+        REQUIRE(result);
+        ifstream.close();
+
+        cppgltf::glTF& gltf = gltfHandler.get();
+        common_check_Box(gltf);
+        REQUIRE(648 == gltf.buffers_[0].byteLength_);
+    }
+
+    SECTION("load text skipping sections"){
+        cppgltf::IFStream ifstream;
+        if(!ifstream.open(text)){
+            return;
+        }
+        cppgltf::glTFHandler gltfHandler(textDir);
+        gltfHandler.setSkipSections(cppgltf::GLTF_SECTION_MATERIALS | cppgltf::GLTF_SECTION_NODES | cppgltf::GLTF_SECTION_SCENES);
+        cppgltf::JSONReader gltfJsonReader(ifstream, gltfHandler);
+        bool result = gltfJsonReader.read();
+        REQUIRE(result);
+        ifstream.close();
+
+        cppgltf::glTF& gltf = gltfHandler.get();
+        REQUIRE(0 == gltf.materials_.size());
+        REQUIRE(0 == gltf.nodes_.size());
+        REQUIRE(0 == gltf.scenes_.size());
+        REQUIRE(1 == gltf.meshes_.size());
+        REQUIRE(3 == gltf.accessors_.size());
+        REQUIRE(2 == gltf.bufferViews_.size());
+        REQUIRE(NULL != gltf.buffers_[0].data_);
+    }
+
+    SECTION("reload with the same handler"){
+        cppgltf::glTFHandler gltfHandler(textDir);
+        cppgltf::s64 reserved = 0;
+        for(int i=0; i<3; ++i){
+            cppgltf::IFStream ifstream;
+            if(!ifstream.open(text)){
+                return;
+            }
+            cppgltf::JSONReader gltfJsonReader(ifstream, gltfHandler);
+            bool result = gltfJsonReader.read();
+            REQUIRE(result);
+            ifstream.close();
+            common_check_Box(gltfHandler.get());
+            if(0<i){
+                REQUIRE(reserved == gltfHandler.getAllocatorStats().reserved_);
+            }
+            reserved = gltfHandler.getAllocatorStats().reserved_;
+        }
+        REQUIRE(0 < gltfHandler.getAllocatorStats().peak_);
+    }
+
+    SECTION("load buffers on a thread pool"){
+        cppgltf::IFStream ifstream;
+        if(!ifstream.open(text)){
+            return;
+        }
+        cppgltf::glTFHandler gltfHandler(textDir);
+        gltfHandler.setFlags(cppgltf::glTFBase::Flag_Parallel);
+        cppgltf::JSONReader gltfJsonReader(ifstream, gltfHandler);
+        bool result = gltfJsonReader.read();
+        REQUIRE(result);
+        ifstream.close();
+
+        cppgltf::glTF& gltf = gltfHandler.get();
+        common_check_Box(gltf);
+        cppgltf::u8 first = gltf.buffers_[0].data_[0];
+        cppgltf::ThreadPool threadPool;
+        threadPool.start(2);
+        REQUIRE(gltf.loadBuffers(&threadPool));
+        REQUIRE(first == gltf.buffers_[0].data_[0]);
+    }
+
+    SECTION("load text with mapped buffers"){
+        cppgltf::IFStream ifstream;
+        if(!ifstream.open(text)){
+            return;
+        }
+        cppgltf::glTFHandler gltfHandler(textDir);
+        gltfHandler.setFlags(cppgltf::glTFBase::Flag_MapBuffers);
+        cppgltf::JSONReader gltfJsonReader(ifstream, gltfHandler);
+        bool result = gltfJsonReader.read();
+        REQUIRE(result);
+        ifstream.close();
+
+        cppgltf::glTF& gltf = gltfHandler.get();
+        common_check_Box(gltf);
+        REQUIRE(0 == gltf.size());
+    }
+
+    SECTION("load text with lazy buffers"){
+        cppgltf::IFStream ifstream;
+        if(!ifstream.open(text)){
+            return;
+        }
+        cppgltf::glTFHandler gltfHandler(textDir);
+        gltfHandler.setFlags(cppgltf::glTFBase::Flag_LazyBuffers);
+        cppgltf::JSONReader gltfJsonReader(ifstream, gltfHandler);
+        bool result = gltfJsonReader.read();
+        REQUIRE(result);
+        ifstream.close();
+
+        cppgltf::glTF& gltf = gltfHandler.get();
+        REQUIRE(NULL == gltf.buffers_[0].data_);
+        const cppgltf::u8* positions = gltf.getAccessorData(1);
+        REQUIRE(NULL != positions);
+        REQUIRE(positions == gltf.buffers_[0].data_ + gltf.bufferViews_[1].byteOffset_ + gltf.accessors_[1].byteOffset_);
+        common_check_Box(gltf);
+    }
+
+    SECTION("load only some bufferViews"){
+        cppgltf::IFStream ifstream;
+        if(!ifstream.open(text)){
+            return;
+        }
+        cppgltf::glTFHandler gltfHandler(textDir);
+        gltfHandler.setFlags(cppgltf::glTFBase::Flag_LazyBuffers);
+        cppgltf::JSONReader gltfJsonReader(ifstream, gltfHandler);
+        bool result = gltfJsonReader.read();
+        REQUIRE(result);
+        ifstream.close();
+
+        cppgltf::glTF& gltf = gltfHandler.get();
+        cppgltf::s32 views[] = {1};
+        REQUIRE(gltf.loadBufferViews(1, views));
+        REQUIRE(NULL == gltf.buffers_[0].data_);
+        REQUIRE(NULL != gltf.getAccessorData(1));
+        REQUIRE(NULL == gltf.buffers_[0].data_);
+    }
+
+    SECTION("load text through a pack file"){
+        //The buffer file serves as a pack which has only itself
+        cppgltf::PackFileProvider pack;
+        if(!pack.openPack(DATA_ROOT"Box/glTF/Box0.bin")){
+            return;
+        }
+        pack.add("Box0.bin", 0, 648);
+        cppgltf::IFStream ifstream;
+        if(!ifstream.open(text)){
+            return;
+        }
+        cppgltf::glTFHandler gltfHandler;
+        gltfHandler.get().setFileProvider(&pack);
+        cppgltf::JSONReader gltfJsonReader(ifstream, gltfHandler);
+        bool result = gltfJsonReader.read();
+        REQUIRE(result);
+        ifstream.close();
+
+        cppgltf::glTF& gltf = gltfHandler.get();
+        common_check_Box(gltf);
+    }
+
     SECTION("load embedded"){
         cppgltf::IFStream ifstream;
         if(!ifstream.open(embedded)){
@@ -193,5 +405,43 @@ TEST_CASE("A sample Box can be loaded", "[Box]"){
 
         cppgltf::glTF& gltf = gltfHandler.get();
         common_check_Box(gltf);
+        REQUIRE(gltf.loadBuffers());
+    }
+
+    SECTION("load embedded mapped"){
+        cppgltf::IMMStream istream;
+        if(!istream.open(embedded)){
+            return;
+        }
+        cppgltf::glTFHandler gltfHandler(textDir);
+        gltfHandler.setFlags(cppgltf::glTFBase::Flag_Parallel);
+        cppgltf::JSONReader gltfJsonReader(istream, gltfHandler);
+        bool result = gltfJsonReader.read();
+        REQUIRE(result);
+        istream.close();
+
+        cppgltf::glTF& gltf = gltfHandler.get();
+        common_check_Box(gltf);
+        //The payload is decoded from the stream, and not copied into uri_
+        REQUIRE(gltf.buffers_[0].uri_ == "data:application/octet-stream;base64,");
+        REQUIRE(NULL == gltf.buffers_[0].source_);
+        REQUIRE(gltf.buffers_[0].sourceLength_ < 0);
+    }
+
+    SECTION("load asynchronously"){
+        cppgltf::AsyncLoader loader;
+        cppgltf::s32 numNodes = 0;
+        bool buffersReady = false;
+        bool result = loader.start(binary, cppgltf::glTFBase::Flag_Parallel,
+            [&numNodes](cppgltf::AsyncLoader& l){ numNodes = l.get().nodes_.size(); },
+            [&buffersReady](cppgltf::AsyncLoader&){ buffersReady = true; });
+        if(!result){
+            return;
+        }
+        loader.wait();
+        REQUIRE(cppgltf::AsyncLoader::State_Done == loader.getState());
+        REQUIRE(2 == numNodes);
+        REQUIRE(buffersReady);
+        common_check_Box(loader.get());
     }
 }
@@ -0,0 +1,642 @@
+#include "config.h"
+#include <cfloat>
+#include <cmath>
+#include <limits>
+#include <string>
+
+namespace
+{
+    /**
+    @brief A file in the build directory, which is removed on leaving the scope even by a failure
+    */
+    class TemporaryFile
+    {
+    public:
+        explicit TemporaryFile(const char* name)
+            :path_(std::string(TEMP_ROOT) + name)
+        {}
+
+        ~TemporaryFile()
+        {
+            remove(path_.c_str());
+        }
+
+        const char* path() const
+        {
+            return path_.c_str();
+        }
+
+        bool write(const void* data, size_t size) const
+        {
+            FILE* file = fopen(path_.c_str(), "wb");
+            if(NULL == file){
+                return false;
+            }
+            bool result = (0 == size) || (1 == fwrite(data, size, 1, file));
+            return (0 == fclose(file)) && result;
+        }
+
+    private:
+        TemporaryFile(const TemporaryFile&) = delete;
+        TemporaryFile& operator=(const TemporaryFile&) = delete;
+
+        std::string path_;
+    };
+
+    /**
+    @brief Build a GLB of a JSON chunk padded with spaces and a BIN chunk
+    */
+    std::string makeGLB(const char* json, const cppgltf::u8* bin, cppgltf::u32 binSize)
+    {
+        std::string chunk(json);
+        chunk.append((4-chunk.size()%4)%4, ' ');
+        const cppgltf::u32 jsonLength = static_cast<cppgltf::u32>(chunk.size());
+        const cppgltf::u32 header[] = {cppgltf::GLBReader::Magic, 2, 12+8+jsonLength+8+binSize};
+        const cppgltf::u32 jsonChunk[] = {jsonLength, cppgltf::GLBReader::ChunkType_JSON};
+        const cppgltf::u32 binChunk[] = {binSize, cppgltf::GLBReader::ChunkType_BIN};
+        std::string glb(reinterpret_cast<const char*>(header), sizeof(header));
+        glb.append(reinterpret_cast<const char*>(jsonChunk), sizeof(jsonChunk));
+        glb.append(chunk);
+        glb.append(reinterpret_cast<const char*>(binChunk), sizeof(binChunk));
+        glb.append(reinterpret_cast<const char*>(bin), binSize);
+        return glb;
+    }
+}
+
+TEST_CASE("Numbers can be parsed", "[Synthetic]"){
+    //The long decimal has more characters than the buffer for a token in a stream
+    static const char json[] = "{\"asset\":{\"version\":\"2.0\"},"
+        "\"accessors\":[{\"componentType\":5126,\"count\":2147483647,\"type\":\"SCALAR\",\"min\":["
+        "0.1,-0,-0.0,1e308,5e-324,2.2250738585072014e-308,9007199254740993,12345678901234567890123,"
+        "0.100000000000000005551115123125782702118158340454101562500000000000000000,"
+        "1e400,-1e400,1e-400,2147483647,-2147483648,2147483648,-2147483649]}]}";
+    TemporaryFile file("parse_numbers.gltf");
+    REQUIRE(file.write(json, sizeof(json)-1));
+
+    for(int i=0; i<2; ++i){
+        cppgltf::glTFHandler gltfHandler;
+        bool result;
+        if(0 == i){
+            cppgltf::ISStream istream(sizeof(json)-1, reinterpret_cast<const cppgltf::u8*>(json));
+            cppgltf::JSONReader gltfJsonReader(istream, gltfHandler);
+            result = gltfJsonReader.read();
+        }else{
+            cppgltf::IFStream ifstream;
+            REQUIRE(ifstream.open(file.path()));
+            cppgltf::JSONReader gltfJsonReader(ifstream, gltfHandler);
+            result = gltfJsonReader.read();
+        }
+        REQUIRE(result);
+
+        const cppgltf::Accessor& accessor = gltfHandler.get().accessors_[0];
+        REQUIRE(2147483647 == accessor.count_);
+        const cppgltf::Number* min = accessor.min_;
+        REQUIRE(0.1 == min[0].fvalue_);
+        REQUIRE(0.0 == min[1].fvalue_);
+        REQUIRE(0.0 == min[2].fvalue_);
+        REQUIRE(std::signbit(min[2].fvalue_));
+        REQUIRE(1e308 == min[3].fvalue_);
+        REQUIRE(std::numeric_limits<double>::denorm_min() == min[4].fvalue_);
+        REQUIRE(DBL_MIN == min[5].fvalue_);
+        //Halfway between two doubles, rounded to the even one
+        REQUIRE(9007199254740992.0 == min[6].fvalue_);
+        REQUIRE(1.2345678901234568e22 == min[7].fvalue_);
+        REQUIRE(0.1 == min[8].fvalue_);
+        REQUIRE(std::numeric_limits<double>::infinity() == min[9].fvalue_);
+        REQUIRE(-std::numeric_limits<double>::infinity() == min[10].fvalue_);
+        REQUIRE(0.0 == min[11].fvalue_);
+        REQUIRE(2147483647.0 == min[12].fvalue_);
+        REQUIRE(-2147483648.0 == min[13].fvalue_);
+        REQUIRE(2147483648.0 == min[14].fvalue_);
+        REQUIRE(-2147483649.0 == min[15].fvalue_);
+    }
+}
+
+TEST_CASE("Several buffers can be loaded on a thread pool", "[Synthetic]"){
+    //The last buffer does not exist
+    static const char json[] = "{\"asset\":{\"version\":\"2.0\"},\"buffers\":["
+        "{\"uri\":\"data:application/octet-stream;base64,AAEC\",\"byteLength\":3},"
+        "{\"uri\":\"data:application/octet-stream;base64,AwQF\",\"byteLength\":3},"
+        "{\"uri\":\"data:application/octet-stream;base64,BgcI\",\"byteLength\":3},"
+        "{\"uri\":\"data:application/octet-stream;base64,CQoL\",\"byteLength\":3},"
+        "{\"uri\":\"missing_pool.bin\",\"byteLength\":3}]}";
+    cppgltf::ISStream istream(sizeof(json)-1, reinterpret_cast<const cppgltf::u8*>(json));
+    cppgltf::glTFHandler gltfHandler;
+    gltfHandler.setFlags(cppgltf::glTFBase::Flag_DeferBuffers);
+    cppgltf::JSONReader gltfJsonReader(istream, gltfHandler);
+    bool result = gltfJsonReader.read();
+    REQUIRE(result);
+
+    cppgltf::glTF& gltf = gltfHandler.get();
+    cppgltf::ThreadPool threadPool;
+    threadPool.start(3);
+    REQUIRE_FALSE(gltf.loadBuffers(&threadPool));
+    for(cppgltf::s32 i=0; i<4; ++i){
+        for(cppgltf::s32 j=0; j<3; ++j){
+            REQUIRE(i*3+j == gltf.buffers_[i].data_[j]);
+        }
+    }
+
+    gltf.buffers_[4].uri_.assign("data:application/octet-stream;base64,DA0O");
+    REQUIRE(gltf.loadBuffers(&threadPool));
+    for(cppgltf::s32 i=0; i<5; ++i){
+        for(cppgltf::s32 j=0; j<3; ++j){
+            REQUIRE(i*3+j == gltf.buffers_[i].data_[j]);
+        }
+    }
+}
+
+TEST_CASE("Arrays can be parsed in parallel after changing the number of threads", "[Synthetic]"){
+    //More nodes than glTFHandler::MinParallelCount, to take the parallel path of the parser
+    std::string json = "{\"asset\":{\"version\":\"2.0\"},\"nodes\":[";
+    for(int i=0; i<300; ++i){
+        json += (0<i)? ",{\"name\":\"node" : "{\"name\":\"node";
+        json += std::to_string(i) + "\"}";
+    }
+    json += "]}";
+
+    cppgltf::glTFHandler gltfHandler;
+    gltfHandler.setFlags(cppgltf::glTFBase::Flag_Parallel);
+    static const cppgltf::s32 numThreads[] = {3, 2, 4, 4};
+    for(int i=0; i<4; ++i){
+        gltfHandler.setNumThreads(numThreads[i]);
+        for(int j=0; j<2; ++j){
+            cppgltf::ISStream istream(json.size(), reinterpret_cast<const cppgltf::u8*>(json.c_str()));
+            cppgltf::JSONReader gltfJsonReader(istream, gltfHandler);
+            bool result = gltfJsonReader.read();
+            REQUIRE(result);
+
+            const cppgltf::glTF& gltf = gltfHandler.get();
+            REQUIRE(300 == gltf.nodes_.size());
+            for(cppgltf::s32 k=0; k<gltf.nodes_.size(); ++k){
+                REQUIRE(("node" + std::to_string(k)) == gltf.nodes_[k].name_.c_str());
+            }
+        }
+    }
+}
+
+TEST_CASE("Byte lengths can be over 32 bits", "[Synthetic]"){
+    static const char json[] = "{\"asset\":{\"version\":\"2.0\"},"
+        "\"buffers\":[{\"uri\":\"Huge.bin\",\"byteLength\":6442450944}],"
+        "\"bufferViews\":[{\"buffer\":0,\"byteOffset\":4294967296,\"byteLength\":2147483648}]}";
+    cppgltf::ISStream istream(sizeof(json)-1, reinterpret_cast<const cppgltf::u8*>(json));
+    cppgltf::glTFHandler gltfHandler;
+    gltfHandler.setFlags(cppgltf::glTFBase::Flag_LazyBuffers);
+    cppgltf::JSONReader gltfJsonReader(istream, gltfHandler);
+    bool result = gltfJsonReader.read();
+    REQUIRE(result);
+
+    cppgltf::glTF& gltf = gltfHandler.get();
+    REQUIRE(6442450944LL == gltf.buffers_[0].byteLength_);
+    REQUIRE(4294967296LL == gltf.bufferViews_[0].byteOffset_);
+    REQUIRE(2147483648LL == gltf.bufferViews_[0].byteLength_);
+}
+
+TEST_CASE("A handler can be reused after referencing a GLB", "[Synthetic]"){
+    static const cppgltf::u8 bin[4] = {1, 2, 3, 4};
+    const std::string glb = makeGLB("{\"asset\":{\"version\":\"2.0\"},\"buffers\":[{\"byteLength\":4}]}", bin, sizeof(bin));
+    TemporaryFile file("reference_reuse.glb");
+    REQUIRE(file.write(glb.data(), glb.size()));
+
+    cppgltf::GLBEventHandler glbHandler;
+    glbHandler.setFlags(cppgltf::glTFBase::Flag_ReferenceGLB);
+    {
+        cppgltf::IMMStream istream;
+        REQUIRE(istream.open(file.path()));
+        cppgltf::GLBReader glbReader(istream, glbHandler);
+        bool result = glbReader.read();
+        REQUIRE(result);
+        glbHandler.get().holdStorage(std::move(istream));
+    }
+    cppgltf::glTF& gltf = glbHandler.get();
+    REQUIRE(4 == gltf.sizeGLB());
+    REQUIRE(0 == memcmp(bin, gltf.getGLB(0), sizeof(bin)));
+
+    //The mapped file and the GLB binary are released by the next parse
+    static const char json[] = "{\"asset\":{\"version\":\"2.0\"}}";
+    cppgltf::ISStream istream(sizeof(json)-1, reinterpret_cast<const cppgltf::u8*>(json));
+    cppgltf::JSONReader jsonReader(istream, glbHandler);
+    bool result = jsonReader.read();
+    REQUIRE(result);
+    REQUIRE(0 == gltf.sizeGLB());
+    REQUIRE(0 == gltf.buffers_.size());
+}
+
+TEST_CASE("Long data URIs can be decoded", "[Synthetic]"){
+    //Long enough for the SIMD blocks, with each padding and an invalid character in the last
+    static const char json[] = "{\"asset\":{\"version\":\"2.0\"},\"buffers\":["
+        "{\"uri\":\"data:application/octet-stream;base64,"
+        "AwoRGB8mLTQ7QklQV15lbHN6gYiPlp2kq7K5wMfO1dzj6vH4/wYNFBsiKTA3PkVMU1phaG92fYSLkpmg\",\"byteLength\":60},"
+        "{\"uri\":\"data:application/octet-stream;base64,"
+        "AwoRGB8mLTQ7QklQV15lbHN6gYiPlp2kq7K5wMfO1dzj6vH4/wYNFBsiKTA3PkVMU1phaG92fYSLkpmgpw==\",\"byteLength\":61},"
+        "{\"uri\":\"data:application/octet-stream;base64,"
+        "AwoRGB8mLTQ7QklQV15lbHN6gYiPlp2kq7K5wMfO1dzj6vH4/wYNFBsiKTA3PkVMU1phaG92fYSLkpmgp64=\",\"byteLength\":62},"
+        "{\"uri\":\"data:application/octet-stream;base64,"
+        "AwoRGB8mLTQ7QklQV15lbHN6gYiPlp2kq7K5wMfO*dzj6vH4/wYNFBsiKTA3PkVMU1phaG92fYSLkpmg\",\"byteLength\":60}]}";
+    cppgltf::ISStream istream(sizeof(json)-1, reinterpret_cast<const cppgltf::u8*>(json));
+    cppgltf::glTFHandler gltfHandler;
+    gltfHandler.setFlags(cppgltf::glTFBase::Flag_DeferBuffers);
+    cppgltf::JSONReader gltfJsonReader(istream, gltfHandler);
+    bool result = gltfJsonReader.read();
+    REQUIRE(result);
+    REQUIRE_FALSE(gltfHandler.loadBuffers());
+
+    const cppgltf::glTF& gltf = gltfHandler.get();
+    for(cppgltf::s32 i=0; i<3; ++i){
+        const cppgltf::Buffer& buffer = gltf.buffers_[i];
+        REQUIRE(60+i == buffer.byteLength_);
+        for(cppgltf::s32 j=0; j<buffer.byteLength_; ++j){
+            REQUIRE(((j*7+3)&0xFF) == buffer.data_[j]);
+        }
+    }
+}
+
+TEST_CASE("Data URIs are decoded once from the stream", "[Synthetic]"){
+    static const char json[] = "{\"asset\":{\"version\":\"2.0\"},"
+        "\"buffers\":[{\"uri\":\"data:application/octet-stream;base64,AQIDBA==\",\"byteLength\":4}]}";
+    cppgltf::glTFHandler gltfHandler;
+    {
+        cppgltf::ISStream istream(sizeof(json)-1, reinterpret_cast<const cppgltf::u8*>(json));
+        cppgltf::JSONReader gltfJsonReader(istream, gltfHandler);
+        bool result = gltfJsonReader.read();
+        REQUIRE(result);
+    }
+
+    //Only the header is kept, the payload is not copied out of the stream
+    cppgltf::glTF& gltf = gltfHandler.get();
+    cppgltf::Buffer& buffer = gltf.buffers_[0];
+    REQUIRE(buffer.uri_ == "data:application/octet-stream;base64,");
+    REQUIRE(NULL == buffer.source_);
+    REQUIRE(buffer.sourceLength_ < 0);
+    for(cppgltf::s32 i=0; i<4; ++i){
+        REQUIRE(i+1 == buffer.data_[i]);
+    }
+
+    //Loading again fails instead of decoding nothing
+    REQUIRE_FALSE(cppgltf::load(buffer, gltf.directory_));
+    REQUIRE_FALSE(gltf.loadBuffers());
+    REQUIRE_FALSE(gltfHandler.loadBuffers());
+}
+
+TEST_CASE("A tar archive can be indexed", "[Synthetic]"){
+    std::string archive;
+    auto addHeader = [&archive](const std::string& name, char type, size_t size){
+        char header[512] = {};
+        memcpy(header, name.c_str(), (name.size()<100)? name.size() : 100);
+        memcpy(header+100, "0000644", 8);
+        snprintf(header+124, 12, "%011o", static_cast<unsigned>(size));
+        header[156] = type;
+        memcpy(header+257, "ustar", 6);
+        memcpy(header+263, "00", 2);
+        memset(header+148, ' ', 8);
+        unsigned checksum = 0;
+        for(char c : header){
+            checksum += static_cast<unsigned char>(c);
+        }
+        snprintf(header+148, 8, "%06o", checksum);
+        archive.append(header, 512);
+    };
+    auto addData = [&archive](const std::string& data){
+        archive.append(data);
+        archive.append((512-data.size()%512)%512, '\0');
+    };
+    const std::string longName = "long/" + std::string(120, 'x') + "/b.bin";
+    addHeader("models/a.bin", '0', 4);
+    addData("\x01\x02\x03\x04");
+    //GNU long name
+    addHeader("././@LongLink", 'L', longName.size()+1);
+    addData(longName + '\0');
+    addHeader(longName.substr(0, 100), '0', 4);
+    addData("\x05\x06\x07\x08");
+    //pax path
+    addHeader("PaxHeader", 'x', 18);
+    addData("18 path=pax/c.bin\n");
+    addHeader("ignored.bin", '0', 4);
+    addData("\x09\x0A\x0B\x0C");
+    //A broken pax record shorter than its key is skipped
+    addHeader("PaxHeader", 'x', 15);
+    addData("5 path=bad.bin\n");
+    addHeader("./d.bin", '0', 4);
+    addData("\x0D\x0E\x0F\x10");
+    //Long names of a directory and a link are not taken by the next files
+    const std::string directoryName = "long/" + std::string(120, 'y') + "/";
+    addHeader("././@LongLink", 'L', directoryName.size()+1);
+    addData(directoryName + '\0');
+    addHeader(directoryName.substr(0, 100), '5', 0);
+    addHeader("e.bin", '0', 4);
+    addData("\x11\x12\x13\x14");
+    addHeader("PaxHeader", 'x', 16);
+    addData("16 path=lnk.bin\n");
+    addHeader("lnk", '2', 0);
+    addHeader("f.bin", '0', 4);
+    addData("\x15\x16\x17\x18");
+    archive.append(1024, '\0');
+
+    TemporaryFile file("pack_test.tar");
+    REQUIRE(file.write(archive.data(), archive.size()));
+
+    cppgltf::PackFileProvider pack;
+    bool result = pack.openPack(file.path());
+    REQUIRE(result);
+    REQUIRE(6 == pack.getNumEntries());
+    const std::string names[] = {"models/a.bin", longName, "pax/c.bin", "d.bin", "e.bin", "f.bin"};
+    cppgltf::String directory;
+    for(int i=0; i<6; ++i){
+        cppgltf::String name;
+        name.assign(names[i].c_str());
+        cppgltf::FileProvider::Handle handle = pack.open(name, directory);
+        REQUIRE(NULL != handle);
+        REQUIRE(4 == pack.size(handle));
+        cppgltf::u8 data[4];
+        REQUIRE(pack.read(handle, 0, 4, data));
+        REQUIRE(i*4+1 == data[0]);
+        REQUIRE(i*4+4 == data[3]);
+        pack.close(handle);
+    }
+    const char* ignoredNames[] = {"ignored.bin", directoryName.c_str(), "lnk.bin"};
+    for(const char* ignoredName : ignoredNames){
+        cppgltf::String ignored;
+        ignored.assign(ignoredName);
+        REQUIRE(NULL == pack.open(ignored, directory));
+    }
+    pack.closePack();
+}
+
+TEST_CASE("Accessors can be read through views", "[Synthetic]"){
+    static const char json[] = "{\"asset\":{\"version\":\"2.0\"},"
+        "\"buffers\":[{\"uri\":\"data:application/octet-stream;base64,AAACAAEAAAAAAIA/AAAAQAAAQEAAAAAAAACAQAAAoEAAAMBAAAAAAA==\",\"byteLength\":40}],"
+        "\"bufferViews\":[{\"buffer\":0,\"byteLength\":6},{\"buffer\":0,\"byteOffset\":8,\"byteLength\":32,\"byteStride\":16}],"
+        "\"accessors\":[{\"bufferView\":0,\"componentType\":5123,\"count\":3,\"type\":\"SCALAR\"},"
+        "{\"bufferView\":1,\"componentType\":5126,\"count\":2,\"type\":\"VEC3\"}]}";
+    cppgltf::ISStream istream(sizeof(json)-1, reinterpret_cast<const cppgltf::u8*>(json));
+    cppgltf::glTFHandler gltfHandler;
+    cppgltf::JSONReader gltfJsonReader(istream, gltfHandler);
+    bool result = gltfJsonReader.read();
+    REQUIRE(result);
+
+    cppgltf::glTF& gltf = gltfHandler.get();
+    cppgltf::AccessorView<cppgltf::u16> indices(gltf, 0);
+    REQUIRE(indices.valid());
+    REQUIRE(3 == indices.size());
+    REQUIRE(indices.isPacked());
+    REQUIRE(NULL != indices.data());
+    cppgltf::u16 maxIndex = 0;
+    indices.forEach([&maxIndex](cppgltf::u16 index){ maxIndex = (maxIndex<index)? index : maxIndex; });
+    REQUIRE(2 == maxIndex);
+    REQUIRE(1 == indices[2]);
+
+    //Padded by the byteStride of the bufferView
+    cppgltf::AccessorView<cppgltf::AccessorVec3f> positions(gltf, 1);
+    REQUIRE(positions.valid());
+    REQUIRE(2 == positions.size());
+    REQUIRE(16 == positions.stride());
+    REQUIRE_FALSE(positions.isPacked());
+    REQUIRE(NULL == positions.data());
+    cppgltf::f32 expected = 1.0f;
+    for(const cppgltf::AccessorVec3f& position : positions){
+        for(cppgltf::s32 i=0; i<3; ++i){
+            REQUIRE(expected == position[i]);
+            expected += 1.0f;
+        }
+    }
+    REQUIRE(7.0f == expected);
+
+    //Neither the componentType nor the type match
+    REQUIRE_FALSE(cppgltf::AccessorView<cppgltf::f32>(gltf, 1).valid());
+    REQUIRE_FALSE(cppgltf::AccessorView<cppgltf::u8>(gltf, 0).valid());
+    REQUIRE_FALSE(cppgltf::AccessorView<cppgltf::u16>(gltf, 2).valid());
+}
+
+TEST_CASE("Normalized accessors can be dequantized", "[Synthetic]"){
+    static const char json[] = "{\"asset\":{\"version\":\"2.0\"},"
+        "\"buffers\":[{\"uri\":\"data:application/octet-stream;base64,AP8HB4BABwc=\",\"byteLength\":8}],"
+        "\"bufferViews\":[{\"buffer\":0,\"byteLength\":8,\"byteStride\":4}],"
+        "\"accessors\":[{\"bufferView\":0,\"componentType\":5121,\"normalized\":true,\"count\":2,\"type\":\"VEC2\"},"
+        "{\"bufferView\":0,\"componentType\":5121,\"count\":2,\"type\":\"VEC2\"}]}";
+    cppgltf::ISStream istream(sizeof(json)-1, reinterpret_cast<const cppgltf::u8*>(json));
+    cppgltf::glTFHandler gltfHandler;
+    cppgltf::JSONReader gltfJsonReader(istream, gltfHandler);
+    bool result = gltfJsonReader.read();
+    REQUIRE(result);
+
+    cppgltf::glTF& gltf = gltfHandler.get();
+    cppgltf::f32 values[4];
+    REQUIRE(cppgltf::dequantize(values, gltf, 0));
+    REQUIRE(0.0f == values[0]);
+    REQUIRE(1.0f == values[1]);
+    REQUIRE(cppgltf::toFloat(static_cast<cppgltf::u8>(128)) == values[2]);
+    REQUIRE(cppgltf::toFloat(static_cast<cppgltf::u8>(64)) == values[3]);
+    REQUIRE_FALSE(cppgltf::dequantize(values, gltf, 1));
+
+    //Out of the range is clamped, and the padding between elements is kept
+    values[0] = -0.5f;
+    values[1] = 2.0f;
+    values[2] = 0.5f;
+    REQUIRE(cppgltf::quantize(gltf, 0, values));
+    const cppgltf::u8* data = gltf.getAccessorData(0);
+    REQUIRE(0 == data[0]);
+    REQUIRE(255 == data[1]);
+    REQUIRE(7 == data[2]);
+    REQUIRE(128 == data[4]);
+    REQUIRE(64 == data[5]);
+}
+
+TEST_CASE("Sparse accessors can be materialized", "[Synthetic]"){
+    static const char json[] = "{\"asset\":{\"version\":\"2.0\"},"
+        "\"buffers\":[{\"uri\":\"data:application/octet-stream;base64,AQMHCQUGBwg=\",\"byteLength\":8}],"
+        "\"bufferViews\":[{\"buffer\":0,\"byteLength\":2},{\"buffer\":0,\"byteOffset\":2,\"byteLength\":2},{\"buffer\":0,\"byteOffset\":4,\"byteLength\":4}],"
+        "\"accessors\":[{\"bufferView\":2,\"componentType\":5121,\"count\":4,\"type\":\"SCALAR\","
+        "\"sparse\":{\"count\":2,\"indices\":{\"bufferView\":0,\"componentType\":5121},\"values\":{\"bufferView\":1}}},"
+        "{\"componentType\":5121,\"count\":4,\"type\":\"SCALAR\","
+        "\"sparse\":{\"count\":2,\"indices\":{\"bufferView\":0,\"componentType\":5121},\"values\":{\"bufferView\":1}}},"
+        "{\"componentType\":5121,\"count\":3,\"type\":\"SCALAR\","
+        "\"sparse\":{\"count\":2,\"indices\":{\"bufferView\":0,\"componentType\":5121},\"values\":{\"bufferView\":1}}},"
+        "{\"bufferView\":2,\"componentType\":5121,\"normalized\":true,\"count\":4,\"type\":\"SCALAR\","
+        "\"sparse\":{\"count\":2,\"indices\":{\"bufferView\":0,\"componentType\":5121},\"values\":{\"bufferView\":1}}},"
+        "{\"bufferView\":2,\"componentType\":5121,\"count\":4,\"type\":\"SCALAR\","
+        "\"sparse\":{\"count\":2,\"indices\":{\"componentType\":5121},\"values\":{\"bufferView\":1}}},"
+        "{\"bufferView\":2,\"componentType\":5121,\"count\":4,\"type\":\"SCALAR\","
+        "\"sparse\":{\"count\":2,\"indices\":{\"bufferView\":0,\"componentType\":5121},\"values\":{}}}]}";
+    cppgltf::ISStream istream(sizeof(json)-1, reinterpret_cast<const cppgltf::u8*>(json));
+    cppgltf::glTFHandler gltfHandler;
+    cppgltf::JSONReader gltfJsonReader(istream, gltfHandler);
+    bool result = gltfJsonReader.read();
+    REQUIRE(result);
+
+    cppgltf::glTF& gltf = gltfHandler.get();
+    //Not the base values without the substitutions
+    REQUIRE_FALSE(cppgltf::AccessorView<cppgltf::u8>(gltf, 0).valid());
+    cppgltf::u8 elements[4];
+    REQUIRE(cppgltf::materialize(elements, gltf, 0));
+    REQUIRE(5 == elements[0]);
+    REQUIRE(7 == elements[1]);
+    REQUIRE(7 == elements[2]);
+    REQUIRE(9 == elements[3]);
+
+    //Without a bufferView, the elements start from zeros
+    REQUIRE(cppgltf::materialize(elements, gltf, 1));
+    REQUIRE(0 == elements[0]);
+    REQUIRE(7 == elements[1]);
+    REQUIRE(0 == elements[2]);
+    REQUIRE(9 == elements[3]);
+
+    //The index 3 is out of 3 elements
+    REQUIRE_FALSE(cppgltf::materialize(elements, gltf, 2));
+
+    //The substitutions are not skipped without the bufferView of the indices or the values
+    REQUIRE_FALSE(cppgltf::materialize(elements, gltf, 4));
+    REQUIRE_FALSE(cppgltf::materialize(elements, gltf, 5));
+
+    //Dequantized with the substitutions, and not quantized into the shared base
+    cppgltf::f32 values[4];
+    REQUIRE(cppgltf::dequantize(values, gltf, 3));
+    REQUIRE(cppgltf::toFloat(static_cast<cppgltf::u8>(5)) == values[0]);
+    REQUIRE(cppgltf::toFloat(static_cast<cppgltf::u8>(7)) == values[1]);
+    REQUIRE(cppgltf::toFloat(static_cast<cppgltf::u8>(7)) == values[2]);
+    REQUIRE(cppgltf::toFloat(static_cast<cppgltf::u8>(9)) == values[3]);
+    REQUIRE_FALSE(cppgltf::quantize(gltf, 3, values));
+    REQUIRE(5 == gltf.getAccessorData(3)[0]);
+}
+
+TEST_CASE("Vertices can be interleaved", "[Synthetic]"){
+    static const char json[] = "{\"asset\":{\"version\":\"2.0\"},"
+        "\"buffers\":[{\"uri\":\"data:application/octet-stream;base64,"
+        "AAAAAAAAgD8AAABAAABAQAAAgEAAAKBAAADAQAAA4EAAAABBAACAPwAAAAAAAAAAAAAAAAAAgL8AAAAAAAAAAAAAAAAAAIA/ChQAAB4oAAAKFAAAHigAAAoUAAAeKAAA\",\"byteLength\":96}],"
+        "\"bufferViews\":[{\"buffer\":0,\"byteLength\":36},{\"buffer\":0,\"byteOffset\":36,\"byteLength\":36},{\"buffer\":0,\"byteOffset\":72,\"byteLength\":24}],"
+        "\"accessors\":[{\"bufferView\":0,\"componentType\":5126,\"count\":3,\"type\":\"VEC3\"},"
+        "{\"bufferView\":1,\"componentType\":5126,\"count\":3,\"type\":\"VEC3\"},"
+        "{\"bufferView\":2,\"componentType\":5121,\"normalized\":true,\"count\":3,\"type\":\"MAT2\"}],"
+        "\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":0,\"NORMAL\":1}},{\"attributes\":{\"POSITION\":0,\"TEXCOORD_0\":2}}]}]}";
+    cppgltf::ISStream istream(sizeof(json)-1, reinterpret_cast<const cppgltf::u8*>(json));
+    cppgltf::glTFHandler gltfHandler;
+    cppgltf::JSONReader gltfJsonReader(istream, gltfHandler);
+    bool result = gltfJsonReader.read();
+    REQUIRE(result);
+
+    cppgltf::glTF& gltf = gltfHandler.get();
+    const cppgltf::Primitive& primitive = gltf.meshes_[0].primitives_[0];
+    cppgltf::VertexLayout layout;
+    REQUIRE(layout.add(cppgltf::GLTF_ATTRIBUTE_POSITION, 0, cppgltf::GLTF_TYPE_FLOAT, 3));
+    REQUIRE(layout.add(cppgltf::GLTF_ATTRIBUTE_NORMAL, 0, cppgltf::GLTF_TYPE_BYTE, 4, true));
+    REQUIRE(16 == layout.getStride(0));
+
+    cppgltf::s32 numVertices = cppgltf::getNumVertices(gltf, primitive);
+    REQUIRE(3 == numVertices);
+    cppgltf::u8 vertices[3*16];
+    cppgltf::u8* streams[] = {vertices};
+    cppgltf::ThreadPool threadPool;
+    threadPool.start(2);
+    REQUIRE(cppgltf::interleave(streams, gltf, primitive, layout, &threadPool));
+    static const cppgltf::s8 normals[3][3] = {{127, 0, 0}, {0, -127, 0}, {0, 0, 127}};
+    for(cppgltf::s32 i=0; i<numVertices; ++i){
+        const cppgltf::u8* vertex = vertices + i*16;
+        cppgltf::f32 position[3];
+        memcpy(position, vertex, sizeof(position));
+        for(cppgltf::s32 j=0; j<3; ++j){
+            REQUIRE(static_cast<cppgltf::f32>(i*3+j) == position[j]);
+        }
+        const cppgltf::s8* normal = reinterpret_cast<const cppgltf::s8*>(vertex + 12);
+        REQUIRE(0 == memcmp(normals[i], normal, 3));
+        //The fourth component which the accessor does not have is 1
+        REQUIRE(127 == normal[3]);
+    }
+
+    //A MAT2 of bytes has 4 components, but its columns are padded
+    cppgltf::VertexLayout matrixLayout;
+    REQUIRE(matrixLayout.add(cppgltf::GLTF_ATTRIBUTE_TEXCOORD, 0, cppgltf::GLTF_TYPE_UNSIGNED_BYTE, 4, true));
+    REQUIRE_FALSE(cppgltf::interleave(streams, gltf, gltf.meshes_[0].primitives_[1], matrixLayout));
+}
+
+TEST_CASE("Indices can be converted into lists", "[Synthetic]"){
+    static const char json[] = "{\"asset\":{\"version\":\"2.0\"},"
+        "\"buffers\":[{\"uri\":\"data:application/octet-stream;base64,AAAAAAEAAAACAAAAAwAAAAQAAAD//wAABwAAAAgAAAAJAAAA/v8AAAoAAAALAAAAAAAAAAEAAAAAAAEA\",\"byteLength\":60}],"
+        "\"bufferViews\":[{\"buffer\":0,\"byteLength\":48},{\"buffer\":0,\"byteOffset\":48,\"byteLength\":12}],"
+        "\"accessors\":[{\"bufferView\":0,\"componentType\":5125,\"count\":5,\"type\":\"SCALAR\"},"
+        "{\"bufferView\":0,\"componentType\":5125,\"count\":12,\"type\":\"SCALAR\"},"
+        "{\"bufferView\":1,\"componentType\":5125,\"count\":3,\"type\":\"SCALAR\"},"
+        "{\"bufferView\":0,\"componentType\":5123,\"count\":21,\"type\":\"SCALAR\"},"
+        "{\"componentType\":5126,\"count\":24,\"type\":\"VEC3\"}],"
+        "\"meshes\":[{\"primitives\":[{\"attributes\":{},\"indices\":0,\"mode\":5},{\"attributes\":{},\"indices\":0,\"mode\":2},"
+        "{\"attributes\":{},\"indices\":1},{\"attributes\":{},\"indices\":2},"
+        "{\"attributes\":{},\"indices\":3},{\"attributes\":{\"POSITION\":4},\"mode\":6}]}]}";
+    cppgltf::ISStream istream(sizeof(json)-1, reinterpret_cast<const cppgltf::u8*>(json));
+    cppgltf::glTFHandler gltfHandler;
+    cppgltf::JSONReader gltfJsonReader(istream, gltfHandler);
+    bool result = gltfJsonReader.read();
+    REQUIRE(result);
+
+    cppgltf::glTF& gltf = gltfHandler.get();
+    const cppgltf::Mesh& mesh = gltf.meshes_[0];
+
+    //The last two of odd triangles are swapped
+    static const cppgltf::u16 strip[9] = {0, 1, 2, 1, 3, 2, 2, 3, 4};
+    REQUIRE(9 == cppgltf::getNumListIndices(gltf, mesh.primitives_[0]));
+    cppgltf::u16 indices[66];
+    REQUIRE(cppgltf::getListIndices(indices, gltf, mesh.primitives_[0]));
+    REQUIRE(0 == memcmp(strip, indices, sizeof(strip)));
+
+    //The loop is closed back to the first
+    static const cppgltf::u16 loop[10] = {0, 1, 1, 2, 2, 3, 3, 4, 4, 0};
+    REQUIRE(cppgltf::GLTF_PRIMITIVE_LINES == cppgltf::getListMode(mesh.primitives_[1].mode_));
+    REQUIRE(10 == cppgltf::getNumListIndices(gltf, mesh.primitives_[1]));
+    REQUIRE(cppgltf::getListIndices(indices, gltf, mesh.primitives_[1]));
+    REQUIRE(0 == memcmp(loop, indices, sizeof(loop)));
+
+    //Narrowed when every index fits in 16 bits
+    static const cppgltf::u16 list[12] = {0, 1, 2, 3, 4, 65535, 7, 8, 9, 65534, 10, 11};
+    REQUIRE(12 == cppgltf::getNumListIndices(gltf, mesh.primitives_[2]));
+    REQUIRE(cppgltf::getListIndices(indices, gltf, mesh.primitives_[2]));
+    REQUIRE(0 == memcmp(list, indices, sizeof(list)));
+
+    //Not narrowed with 65536
+    REQUIRE_FALSE(cppgltf::getListIndices(indices, gltf, mesh.primitives_[3]));
+    cppgltf::u32 wide[21];
+    REQUIRE(cppgltf::getListIndices(wide, gltf, mesh.primitives_[3]));
+    REQUIRE(65536 == wide[2]);
+
+    //Widened from 16 bits
+    REQUIRE(21 == cppgltf::getNumListIndices(gltf, mesh.primitives_[4]));
+    REQUIRE(cppgltf::getListIndices(wide, gltf, mesh.primitives_[4]));
+    cppgltf::AccessorView<cppgltf::u16> source(gltf, 3);
+    for(cppgltf::s32 i=0; i<21; ++i){
+        REQUIRE(source[i] == wide[i]);
+    }
+
+    //A fan of the 24 vertices without indices
+    REQUIRE(cppgltf::GLTF_PRIMITIVE_TRIANGLES == cppgltf::getListMode(mesh.primitives_[5].mode_));
+    REQUIRE(66 == cppgltf::getNumListIndices(gltf, mesh.primitives_[5]));
+    REQUIRE(cppgltf::getListIndices(indices, gltf, mesh.primitives_[5]));
+    REQUIRE(1 == indices[0]);
+    REQUIRE(2 == indices[1]);
+    REQUIRE(0 == indices[2]);
+    REQUIRE(22 == indices[63]);
+    REQUIRE(23 == indices[64]);
+    REQUIRE(0 == indices[65]);
+}
+
+TEST_CASE("A GLB which fails can be loaded asynchronously", "[Synthetic]"){
+    //The BIN chunk is used in place, and the second buffer does not exist
+    static const cppgltf::u8 bin[4] = {1, 2, 3, 4};
+    const std::string glb = makeGLB("{\"asset\":{\"version\":\"2.0\"},"
+        "\"buffers\":[{\"byteLength\":4},{\"uri\":\"missing_async.bin\",\"byteLength\":4}]}", bin, sizeof(bin));
+    TemporaryFile file("async_failure.glb");
+    REQUIRE(file.write(glb.data(), glb.size()));
+
+    //Restarted many times, for the callback to run before start returns
+    cppgltf::AsyncLoader loader;
+    for(int i=0; i<200; ++i){
+        bool restarted = true;
+        const char* path = file.path();
+        bool result = loader.start(path, 0, cppgltf::AsyncLoader::Callback(),
+            [&restarted, path](cppgltf::AsyncLoader& l){ restarted = l.start(path, 0, cppgltf::AsyncLoader::Callback(), cppgltf::AsyncLoader::Callback()); });
+        REQUIRE(result);
+        loader.wait();
+        REQUIRE(cppgltf::AsyncLoader::State_Failed == loader.getState());
+        //Not from the callback on the worker
+        REQUIRE_FALSE(restarted);
+        const cppgltf::glTF& gltf = loader.get();
+        REQUIRE(2 == gltf.buffers_.size());
+        REQUIRE(NULL != gltf.buffers_[0].data_);
+        REQUIRE(0 == memcmp(bin, gltf.buffers_[0].data_, sizeof(bin)));
+    }
+}
@@ -4,6 +4,8 @@
 #include <vector>
 #include <iostream>
 #include <fstream>
+#include <algorithm>
+#include <cstdint>
 
 typedef int8_t s8;
 typedef int16_t s16;
@@ -30,6 +32,69 @@ u32 hash_FNV1a(const u8* v, u32 count)
     return hash;
 }
 
+/**
+@brief Must be the same as displaceKey in cppgltf.h
+*/
+u32 displaceKey(u32 hash, u32 displacement)
+{
+    u32 x = hash ^ (displacement*0x9E3779B9U);
+    x = (x ^ (x>>16)) * 0x85EBCA6BU;
+    return x ^ (x>>13);
+}
+
+/**
+@brief Find displacements of a minimal perfect hash, hash, displace and compress
+@return false if failed
+*/
+bool createPerfectHash(std::vector<u32>& displacements, std::vector<s32>& slots, const std::vector<std::string>& words, u32 numBuckets)
+{
+    std::vector<u32> hashes(words.size());
+    std::vector<std::vector<s32>> buckets(numBuckets);
+    for(std::size_t i=0; i<words.size(); ++i){
+        hashes[i] = hash_FNV1a(reinterpret_cast<const u8*>(words[i].c_str()), static_cast<u32>(words[i].size()));
+        buckets[hashes[i]%numBuckets].push_back(static_cast<s32>(i));
+    }
+    std::vector<u32> order(numBuckets);
+    for(u32 i=0; i<numBuckets; ++i){
+        order[i] = i;
+    }
+    //Place larger buckets first
+    std::stable_sort(order.begin(), order.end(), [&buckets](u32 x0, u32 x1){ return buckets[x1].size()<buckets[x0].size();});
+
+    u32 numWords = static_cast<u32>(words.size());
+    displacements.assign(numBuckets, 0);
+    slots.assign(numWords, -1);
+    std::vector<u32> candidates;
+    for(u32 i=0; i<numBuckets; ++i){
+        const std::vector<s32>& bucket = buckets[order[i]];
+        if(bucket.empty()){
+            break;
+        }
+        bool found = false;
+        for(u32 d=0; d<0x10000U && !found; ++d){
+            candidates.clear();
+            found = true;
+            for(std::size_t j=0; j<bucket.size(); ++j){
+                u32 slot = displaceKey(hashes[bucket[j]], d)%numWords;
+                if(0<=slots[slot] || candidates.end() != std::find(candidates.begin(), candidates.end(), slot)){
+                    found = false;
+                    break;
+                }
+                candidates.push_back(slot);
+            }
+            if(found){
+                displacements[order[i]] = d;
+                for(std::size_t j=0; j<bucket.size(); ++j){
+                    slots[candidates[j]] = bucket[j];
+                }
+            }
+        }
+        if(!found){
+            return false;
+        }
+    }
+    return true;
+}
 
 int main(int argc, char** argv)
 {
@@ -57,9 +122,6 @@ int main(int argc, char** argv)
             if(2<=line.size() &&  line[0]=='/' && line[1]=='/'){
                 continue;
             }
-            for(std::size_t j=0; j<line.size(); ++j){
-                line[j] = toupper(line[j]);
-            }
             bool found=false;
             for(std::size_t j=0; j<words.size(); ++j){
                 if(words[j] == line){
@@ -75,6 +137,15 @@ int main(int argc, char** argv)
     }
     file.close();
 
+    //Keys are case sensitive
+    std::vector<u32> displacements;
+    std::vector<s32> slots;
+    u32 numBuckets = static_cast<u32>(words.size()+3)/4;
+    if(!createPerfectHash(displacements, slots, words, numBuckets)){
+        std::cerr << "failed to create a perfect hash" << std::endl;
+        return 1;
+    }
+
     std::ofstream outfile;
 
     outfile.open(argv[2], std::ios::binary);
@@ -82,7 +153,11 @@ int main(int argc, char** argv)
         return 0;
     }
     for(std::size_t i=0; i<words.size(); ++i){
-        outfile << "    static const s32 GLTF_" << words[i].c_str() << " = " << i << ";" << std::endl;
+        std::string name = words[i];
+        for(std::size_t j=0; j<name.size(); ++j){
+            name[j] = toupper(name[j]);
+        }
+        outfile << "    static const s32 GLTF_" << name.c_str() << " = " << i << ";" << std::endl;
     }
     outfile.close();
 
@@ -92,13 +167,25 @@ int main(int argc, char** argv)
     }
 
     outfile << "namespace {" << std::endl;
-    outfile << "    struct Word{ u32 hash_; const char* str_;};" << std::endl;
+    outfile << "    struct Word{ s32 code_; s32 length_; const char* str_;};" << std::endl;
     outfile << "    static const s32 NumWords = " << words.size() << ";" << std::endl;
-    outfile << "    const Word words[] =" << std::endl;
+    outfile << "    static const s32 NumKeyBuckets = " << numBuckets << ";" << std::endl;
+    outfile << "    constexpr u16 keyDisplacements[NumKeyBuckets] =" << std::endl;
     outfile << "    {" << std::endl;
-    for(std::size_t i=0; i<words.size(); ++i){
-        u32 hash = hash_FNV1a(reinterpret_cast<const u8*>(words[i].c_str()), words[i].size());
-        outfile << "        {" << hash << "U,\"" << words[i] << "\"}," << std::endl;
+    for(u32 i=0; i<numBuckets; i+=8){
+        outfile << "       ";
+        for(u32 j=i; j<numBuckets && j<(i+8); ++j){
+            outfile << " " << displacements[j] << "U,";
+        }
+        outfile << std::endl;
+    }
+    outfile << "    };" << std::endl;
+    outfile << "    //Sorted by slots of the perfect hash" << std::endl;
+    outfile << "    constexpr Word words[NumWords] =" << std::endl;
+    outfile << "    {" << std::endl;
+    for(std::size_t i=0; i<slots.size(); ++i){
+        const std::string& word = words[slots[i]];
+        outfile << "        {" << slots[i] << "," << word.size() << ",\"" << word << "\"}," << std::endl;
     }
     outfile << "    };" << std::endl;
     outfile << "}" << std::endl;